@@ -0,0 +1,25 @@
+#include "bench.hpp"
+
+#include <cstring>
+
+int main(int argc, char** argv){
+    bench::config cfg;
+
+    for(int i = 1; i < argc; ++i){
+        if(!std::strncmp(argv[i], "--max-size=", 11)){
+            cfg.max_size = static_cast<size_t>(std::strtod(argv[i] + 11, nullptr));
+        }else if(!std::strncmp(argv[i], "--min-time-ms=", 14)){
+            cfg.min_time_ms = std::strtod(argv[i] + 14, nullptr);
+        }else if(!std::strcmp(argv[i], "--help")){
+            std::printf("usage: %s [--max-size=N] [--min-time-ms=N] [filter...]\n", argv[0]);
+            return 0;
+        }else{
+            cfg.filters.push_back(argv[i]);
+        }
+    }
+
+    bench::print_header();
+    for(const auto& suite: bench::suites()){
+        suite.second(cfg);
+    }
+}
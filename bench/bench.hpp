@@ -0,0 +1,252 @@
+#ifndef BENCH_RDSL_17102026
+#define BENCH_RDSL_17102026
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * A small self-contained benchmark harness.
+ *
+ * Suites register themselves with BENCH_SUITE and are run by bench.cpp's main, which takes
+ *   --max-size=N       skip any measurement on more than N elements (default 2^20)
+ *   --min-time-ms=N    repeat each measurement for at least N milliseconds (default 50)
+ *   filters...         only run measurements whose "suite/name" contains one of them
+ */
+namespace bench{
+
+struct config{
+    size_t max_size = size_t(1) << 20;
+    double min_time_ms = 50;
+    std::vector<std::string> filters;
+
+    bool selected(const std::string& name) const{
+        if(filters.empty()){
+            return true;
+        }
+        for(const std::string& filter: filters){
+            if(name.find(filter) != std::string::npos){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Counters shared by every counting_allocator.
+ */
+struct allocation_stats{
+    size_t allocations = 0;
+    size_t bytes = 0; // currently allocated
+    size_t peak = 0;
+
+    void reset() noexcept{
+        allocations = 0;
+        peak = bytes;
+    }
+};
+
+inline allocation_stats& stats() noexcept{
+    static allocation_stats s;
+    return s;
+}
+
+template<class T>
+struct counting_allocator{
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n){
+        allocation_stats& s = stats();
+        ++s.allocations;
+        s.bytes += n * sizeof(T);
+        s.peak = std::max(s.peak, s.bytes);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept{
+        stats().bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(const counting_allocator<U>&) const noexcept{ return true; }
+
+    template<class U>
+    bool operator!=(const counting_allocator<U>&) const noexcept{ return false; }
+};
+
+/**
+ * @brief Handed to every measured body, which may pause the clock around its setup.
+ */
+struct state{
+    using clock = std::chrono::steady_clock;
+
+    void pause() noexcept{
+        elapsed += clock::now() - started;
+    }
+
+    void resume() noexcept{
+        started = clock::now();
+    }
+
+    clock::time_point started;
+    clock::duration elapsed{};
+};
+
+struct result{
+    std::string name;
+    std::string container;
+    size_t size;
+    double ns_per_op;
+    double allocations; // per repetition
+    size_t peak_bytes;
+    double gb_per_s;    // of element bytes processed, 0 when not measured
+};
+
+inline void print_header(){
+    std::printf("%-40s %-28s %12s %12s %12s %14s %8s\n", "benchmark", "container", "size", "ns/op", "allocs", "peak bytes", "GB/s");
+}
+
+inline void print(const result& r){
+    std::printf("%-40s %-28s %12zu %12.3f %12.1f %14zu ",
+        r.name.c_str(), r.container.c_str(), r.size, r.ns_per_op, r.allocations, r.peak_bytes);
+    if(r.gb_per_s){
+        std::printf("%8.2f\n", r.gb_per_s);
+    }else{
+        std::printf("%8s\n", "-");
+    }
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Runs body(state&) until at least *min_time_ms* of unpaused time has been spent in it,
+ * each run performing *ops* operations, then prints the average time per operation. Runs that move
+ * *bytes* bytes of elements also get their throughput printed.
+ */
+template<class Body>
+void run(const config& cfg, const std::string& name, const std::string& container, size_t size, size_t ops, Body body, size_t bytes = 0){
+    if(size > cfg.max_size || !cfg.selected(name)){
+        return;
+    }
+
+    state st;
+    size_t reps = 0;
+    stats().reset();
+
+    const auto min_time = std::chrono::duration<double, std::milli>(cfg.min_time_ms);
+    while(st.elapsed < min_time || !reps){
+        st.resume();
+        body(st);
+        st.pause();
+        ++reps;
+    }
+
+    const double ns = std::chrono::duration<double, std::nano>(st.elapsed).count();
+    print({
+        name, container, size, ns / (double(reps) * (ops ? ops : 1)), double(stats().allocations) / reps, stats().peak,
+        double(bytes) * reps / ns
+    });
+}
+
+/**
+ * @brief The sizes from 16 to 10^8 every suite sweeps over, trimmed by --max-size.
+ */
+inline std::vector<size_t> sizes(const config& cfg){
+    std::vector<size_t> all;
+    for(size_t size: {size_t(16), size_t(256), size_t(4096), size_t(65536), size_t(1) << 20, size_t(1) << 24, size_t(100000000)}){
+        if(size <= cfg.max_size){
+            all.push_back(size);
+        }
+    }
+    return all;
+}
+
+// Element types every suite is instantiated with, from a plain int to heap owning strings.
+struct fat{
+    unsigned char bytes[64];
+};
+
+template<class T>
+struct element;
+
+template<>
+struct element<int>{
+    static const char* name(){ return "int"; }
+    static int make(size_t i){ return static_cast<int>(i); }
+    static size_t weight(const int& val){ return static_cast<size_t>(val); }
+};
+
+template<>
+struct element<fat>{
+    static const char* name(){ return "fat64"; }
+    static fat make(size_t i){
+        fat f;
+        std::fill(f.bytes, f.bytes + sizeof(f.bytes), static_cast<unsigned char>(i));
+        return f;
+    }
+    static size_t weight(const fat& val){ return val.bytes[0]; }
+};
+
+template<>
+struct element<std::string>{
+    static const char* name(){ return "string"; }
+    static std::string make(size_t i){ return std::string(32, static_cast<char>('a' + i % 26)); }
+    static size_t weight(const std::string& val){ return val.size(); }
+};
+
+/**
+ * @brief Defeats dead code elimination of a benchmarked result.
+ */
+template<class T>
+inline void do_not_optimize(const T& val){
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&val) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &val;
+#endif
+}
+
+/**
+ * @brief A cheap deterministic pseudo random sequence, so every container sees the same positions.
+ */
+struct xorshift{
+    unsigned long long x = 88172645463325252ull;
+
+    size_t operator()(size_t bound) noexcept{
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return static_cast<size_t>(x % bound);
+    }
+};
+
+using suite_fn = void(*)(const config&);
+
+inline std::vector<std::pair<const char*, suite_fn>>& suites(){
+    static std::vector<std::pair<const char*, suite_fn>> all;
+    return all;
+}
+
+struct registrar{
+    registrar(const char* name, suite_fn fn){
+        suites().emplace_back(name, fn);
+    }
+};
+
+#define BENCH_SUITE(name, fn) static ::bench::registrar bench_registrar_##fn(name, &fn)
+
+} //bench
+
+#endif
@@ -0,0 +1,106 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+
+#include <cstdint>
+
+/**
+ * Bulk copies & fills of trivially copyable elements: copy construction, copy assignment, assign & insert,
+ * for devector against std::vector, in GB/s of elements written.
+ */
+namespace{
+
+using namespace bench;
+
+template<class T> struct trivial;
+template<> struct trivial<std::uint8_t>{ static const char* name(){ return "uint8"; } };
+template<> struct trivial<double>{ static const char* name(){ return "double"; } };
+
+template<class T> std::string name(const rdsl::devector<T, counting_allocator<T>>&){ return std::string("devector<") + trivial<T>::name() + ">"; }
+template<class T> std::string name(const std::vector<T, counting_allocator<T>>&){ return std::string("std::vector<") + trivial<T>::name() + ">"; }
+
+template<class C>
+void copy_construct(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const C source(n, T(3));
+
+    run(cfg, "bulk/copy_construct", name(source), n, n, [&](state&){
+        C c(source);
+        do_not_optimize(c);
+    }, n * sizeof(T));
+}
+
+template<class C>
+void copy_assign(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const C source(n, T(3));
+    C c(n, T(1));
+
+    run(cfg, "bulk/copy_assign", name(source), n, n, [&](state&){
+        c = source;
+        do_not_optimize(c);
+    }, n * sizeof(T));
+}
+
+template<class C>
+void assign_fill(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    C c(n, T(1));
+
+    run(cfg, "bulk/assign_fill", name(c), n, n, [&](state&){
+        c.assign(n, T(7));
+        do_not_optimize(c);
+    }, n * sizeof(T));
+}
+
+template<class C>
+void assign_copy(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const std::vector<T> source(n, T(3));
+    C c(n, T(1));
+
+    run(cfg, "bulk/assign_copy", name(c), n, n, [&](state&){
+        c.assign(source.data(), source.data() + n);
+        do_not_optimize(c);
+    }, n * sizeof(T));
+}
+
+// Inserts n elements in the middle of n others, counting only the bytes inserted.
+template<class C>
+void insert_fill(const config& cfg, size_t n){
+    using T = typename C::value_type;
+
+    run(cfg, "bulk/insert_fill", name(C()), n, n, [&](state& st){
+        st.pause();
+        C c(n, T(1));
+        c.reserve(2 * n);
+        st.resume();
+
+        c.insert(c.begin() + n / 2, n, T(7));
+        do_not_optimize(c);
+    }, n * sizeof(T));
+}
+
+template<class T>
+void all_bulk(const config& cfg, size_t n){
+    copy_construct<rdsl::devector<T, counting_allocator<T>>>(cfg, n);
+    copy_construct<std::vector<T, counting_allocator<T>>>(cfg, n);
+    copy_assign<rdsl::devector<T, counting_allocator<T>>>(cfg, n);
+    copy_assign<std::vector<T, counting_allocator<T>>>(cfg, n);
+    assign_fill<rdsl::devector<T, counting_allocator<T>>>(cfg, n);
+    assign_fill<std::vector<T, counting_allocator<T>>>(cfg, n);
+    assign_copy<rdsl::devector<T, counting_allocator<T>>>(cfg, n);
+    assign_copy<std::vector<T, counting_allocator<T>>>(cfg, n);
+    insert_fill<rdsl::devector<T, counting_allocator<T>>>(cfg, n);
+    insert_fill<std::vector<T, counting_allocator<T>>>(cfg, n);
+}
+
+void bulk(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        all_bulk<std::uint8_t>(cfg, n);
+        all_bulk<double>(cfg, n);
+    }
+}
+
+BENCH_SUITE("bulk", bulk);
+
+} //namespace
@@ -0,0 +1,135 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+
+#include <cstdint>
+
+/**
+ * Equality, lexicographic compare, find & count over devectors of integers, the vectorized kernels
+ * devector dispatches to against the element by element loops it used before. Every measurement scans
+ * the whole range, the difference or the value looked for sits in the last element.
+ */
+namespace{
+
+using namespace bench;
+
+template<class T> struct integer;
+template<> struct integer<std::int32_t>{ static const char* name(){ return "int32"; } };
+template<> struct integer<std::uint64_t>{ static const char* name(){ return "uint64"; } };
+
+template<class T>
+std::string describe(const char* how){
+    return std::string(how) + "<" + integer<T>::name() + ">";
+}
+
+template<class T>
+bool scalar_equal(const rdsl::devector<T>& lhs, const rdsl::devector<T>& rhs){
+    if(lhs.size() != rhs.size()){
+        return false;
+    }
+    for(auto it0 = lhs.begin(), it1 = rhs.begin(); it0 != lhs.end(); ++it0, ++it1){
+        if(*it0 != *it1){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class T>
+bool scalar_less(const rdsl::devector<T>& lhs, const rdsl::devector<T>& rhs){
+    auto it1 = rhs.cbegin();
+    for(auto it0 = lhs.cbegin(); it0 != lhs.cend(); ++it0, ++it1){
+        if(it1 == rhs.cend() || *it1 < *it0){
+            return false;
+        }else if(*it0 < *it1){
+            return true;
+        }
+    }
+    return it1 != rhs.cend();
+}
+
+template<class T>
+size_t scalar_find(const rdsl::devector<T>& vec, T val){
+    size_t i = 0;
+    while(i < vec.size() && vec[i] != val){
+        ++i;
+    }
+    return i;
+}
+
+template<class T>
+size_t scalar_count(const rdsl::devector<T>& vec, T val){
+    size_t count = 0;
+    for(const T& x: vec){
+        count += x == val;
+    }
+    return count;
+}
+
+template<class T>
+void kernels(const config& cfg, size_t n){
+    rdsl::devector<T> lhs;
+    for(size_t i = 0; i < n; ++i){
+        lhs.push_back(T(i % 100));
+    }
+    rdsl::devector<T> rhs = lhs;
+    rhs.back() = T(100);
+    const size_t bytes = n * sizeof(T);
+
+    run(cfg, "compare/equal", describe<T>("scalar"), n, n, [&](state&){
+        do_not_optimize(scalar_equal(lhs, rhs));
+    }, 2 * bytes);
+
+    run(cfg, "compare/equal", describe<T>("devector"), n, n, [&](state&){
+        do_not_optimize(lhs == rhs);
+    }, 2 * bytes);
+
+    run(cfg, "compare/less", describe<T>("scalar"), n, n, [&](state&){
+        do_not_optimize(scalar_less(lhs, rhs));
+    }, 2 * bytes);
+
+    run(cfg, "compare/less", describe<T>("devector"), n, n, [&](state&){
+        do_not_optimize(lhs < rhs);
+    }, 2 * bytes);
+
+    run(cfg, "compare/find", describe<T>("scalar"), n, n, [&](state&){
+        do_not_optimize(scalar_find(rhs, T(100)));
+    }, bytes);
+
+    run(cfg, "compare/find", describe<T>("devector"), n, n, [&](state&){
+        do_not_optimize(rhs.find(T(100)));
+    }, bytes);
+
+    run(cfg, "compare/count", describe<T>("scalar"), n, n, [&](state&){
+        do_not_optimize(scalar_count(lhs, T(7)));
+    }, bytes);
+
+    run(cfg, "compare/count", describe<T>("devector"), n, n, [&](state&){
+        do_not_optimize(lhs.count(T(7)));
+    }, bytes);
+
+#if defined(DEVECTOR_SIMD_SSE2)
+    // The SSE2 kernels on their own, to tell them apart from AVX2 on machines dispatching to the latter.
+    const unsigned char* const x = reinterpret_cast<const unsigned char*>(&*lhs.begin());
+    const unsigned char* const y = reinterpret_cast<const unsigned char*>(&*rhs.begin());
+    const rdsl::simd::pattern<T> hundred(T(100));
+
+    run(cfg, "compare/equal", describe<T>("sse2"), n, n, [&](state&){
+        do_not_optimize(rdsl::simd::sse2::mismatch(x, y, bytes) == bytes);
+    }, 2 * bytes);
+
+    run(cfg, "compare/find", describe<T>("sse2"), n, n, [&](state&){
+        do_not_optimize(rdsl::simd::sse2::find<sizeof(T)>(y, bytes, hundred.bytes));
+    }, bytes);
+#endif
+}
+
+void compare(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        kernels<std::int32_t>(cfg, n);
+        kernels<std::uint64_t>(cfg, n);
+    }
+}
+
+BENCH_SUITE("compare", compare);
+
+} //namespace
@@ -0,0 +1,270 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/spsc_queue.hpp"
+#include "rdsl/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/**
+ * spsc_queue against a mutex guarded devector, and a work stealing thread pool built on work_stealing_deque.
+ *
+ * counting_allocator isn't thread safe, so allocations aren't counted here.
+ */
+namespace{
+
+using namespace bench;
+
+using steady_clock = std::chrono::steady_clock;
+
+long long now_ns() noexcept{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct spsc{
+    static const char* name(){ return "spsc_queue<long long>"; }
+
+    void push(long long val){
+        q.push(val);
+    }
+
+    bool try_pop(long long& out){
+        return q.try_pop(out);
+    }
+
+    rdsl::spsc_queue<long long> q;
+};
+
+struct locked{
+    static const char* name(){ return "mutex + devector<long long>"; }
+
+    void push(long long val){
+        std::lock_guard<std::mutex> lock(m);
+        q.push_back(val);
+    }
+
+    bool try_pop(long long& out){
+        std::lock_guard<std::mutex> lock(m);
+        if(q.empty()){
+            return false;
+        }
+        out = q.front();
+        q.pop_front();
+        return true;
+    }
+
+    std::mutex m;
+    rdsl::devector<long long> q;
+};
+
+// A producer thread streaming n elements to the calling thread as fast as they're taken.
+template<class Queue>
+void throughput(const config& cfg, size_t n){
+    run(cfg, "concurrency/throughput", Queue::name(), n, n, [&](state&){
+        Queue q;
+        std::thread producer([&]{
+            for(size_t i = 0; i < n; ++i){
+                q.push(static_cast<long long>(i));
+            }
+        });
+
+        long long sum = 0, val;
+        for(size_t received = 0; received < n;){
+            if(q.try_pop(val)){
+                sum += val;
+                ++received;
+            }else{
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+// Time from push to pop, with at most 64 elements in flight so queueing doesn't dominate it.
+template<class Queue>
+void latency(const config& cfg, size_t n){
+    const std::string container = Queue::name();
+    if(n > cfg.max_size || !(cfg.selected("concurrency/latency_p50") || cfg.selected("concurrency/latency_p99"))){
+        return;
+    }
+
+    Queue q;
+    std::atomic<size_t> received(0);
+    std::thread producer([&]{
+        for(size_t i = 0; i < n; ++i){
+            while(i - received.load(std::memory_order_acquire) >= 64){
+                std::this_thread::yield();
+            }
+            q.push(now_ns());
+        }
+    });
+
+    std::vector<long long> samples;
+    samples.reserve(n);
+    long long sent;
+    while(samples.size() < n){
+        if(q.try_pop(sent)){
+            samples.push_back(now_ns() - sent);
+            received.store(samples.size(), std::memory_order_release);
+        }else{
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    std::sort(samples.begin(), samples.end());
+    print({"concurrency/latency_p50", container, n, double(samples[n / 2]), 0, 0, 0});
+    print({"concurrency/latency_p99", container, n, double(samples[n / 100 * 99]), 0, 0, 0});
+}
+
+// Keeps per worker counters on cache lines of their own.
+struct counter{
+    unsigned long long value = 0;
+    char pad_[rdsl::cache_line_size - sizeof(unsigned long long)];
+};
+
+template<class Task>
+struct spawner{
+    void operator()(const Task& child){
+        pending.fetch_add(1, std::memory_order_relaxed);
+        own.push_back(child);
+    }
+
+    std::atomic<size_t>& pending;
+    rdsl::work_stealing_deque<Task>& own;
+};
+
+/**
+ * @brief Runs *root* & every task it spawns on *threads* workers, each owning a work_stealing_deque
+ * and stealing from a random other one when it runs out of work.
+ *
+ * execute(self, task, spawn) runs a task on worker *self*, calling spawn(child) for every task it forks.
+ */
+template<class Task, class Execute>
+void pool(size_t threads, Task root, Execute execute){
+    std::vector<std::unique_ptr<rdsl::work_stealing_deque<Task>>> deques;
+    for(size_t i = 0; i < threads; ++i){
+        deques.emplace_back(new rdsl::work_stealing_deque<Task>());
+    }
+
+    // Children are counted before their parent is done, so this only reaches zero once everything ran.
+    std::atomic<size_t> pending(1);
+    deques[0]->push_back(root);
+
+    auto worker = [&](size_t self){
+        rdsl::work_stealing_deque<Task>& own = *deques[self];
+        spawner<Task> spawn{pending, own};
+
+        xorshift rng;
+        rng.x += self;
+        Task task;
+        while(pending.load(std::memory_order_acquire)){
+            if(!own.pop_back(task)){
+                const size_t victim = rng(threads);
+                if(victim == self || !deques[victim]->steal_front(task)){
+                    std::this_thread::yield();
+                    continue;
+                }
+            }
+            execute(self, task, spawn);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(size_t i = 1; i < threads; ++i){
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for(std::thread& t: workers){
+        t.join();
+    }
+}
+
+// The number of calls naive recursive fib(n) makes, 2 * fib(n + 1) - 1.
+size_t fib_calls(int n){
+    size_t a = 0, b = 1;
+    for(int i = 0; i <= n; ++i){
+        b += a;
+        a = b - a;
+    }
+    return 2 * a - 1;
+}
+
+// Naive recursive fibonacci, one task per call.
+void fib(const config& cfg, size_t threads, int n){
+    const size_t tasks = fib_calls(n);
+    const std::string container = "work_stealing_deque x" + std::to_string(threads);
+
+    run(cfg, "concurrency/pool/fib", container, tasks, tasks, [&](state&){
+        std::vector<counter> sums(threads);
+        pool(threads, n, [&](size_t self, int k, spawner<int>& spawn){
+            if(k < 2){
+                sums[self].value += k;
+            }else{
+                spawn(k - 1);
+                spawn(k - 2);
+            }
+        });
+        do_not_optimize(sums);
+    });
+}
+
+// Sums an array, halving ranges until they're at most 1024 elements long.
+void parallel_for(const config& cfg, size_t threads, size_t n){
+    const std::vector<int> data(n, 1);
+    const std::string container = "work_stealing_deque x" + std::to_string(threads);
+
+    run(cfg, "concurrency/pool/for", container, n, n, [&](state&){
+        std::vector<counter> sums(threads);
+        // A range packed into one word, so tasks stay trivially copyable & lock free.
+        pool(threads, static_cast<unsigned long long>(n), [&](size_t self, unsigned long long range, spawner<unsigned long long>& spawn){
+            const size_t begin = static_cast<size_t>(range >> 32), end = static_cast<size_t>(range & 0xffffffffu);
+            if(end - begin <= 1024){
+                for(size_t i = begin; i < end; ++i){
+                    sums[self].value += data[i];
+                }
+            }else{
+                const unsigned long long mid = begin + (end - begin) / 2;
+                spawn(static_cast<unsigned long long>(begin) << 32 | mid);
+                spawn(mid << 32 | end);
+            }
+        });
+        do_not_optimize(sums);
+    });
+}
+
+void concurrency(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        if(n < 4096){
+            continue;
+        }
+
+        throughput<spsc>(cfg, n);
+        throughput<locked>(cfg, n);
+
+        if(n <= size_t(1) << 20){
+            latency<spsc>(cfg, n);
+            latency<locked>(cfg, n);
+        }
+    }
+
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for(size_t threads = 1; threads <= hardware; threads *= 2){
+        for(int n: {15, 20, 25}){
+            fib(cfg, threads, n);
+        }
+        for(size_t n: sizes(cfg)){
+            if(n >= 4096 && n <= 0xffffffffu){
+                parallel_for(cfg, threads, n);
+            }
+        }
+    }
+}
+
+BENCH_SUITE("concurrency", concurrency);
+
+} //namespace
@@ -0,0 +1,214 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+
+#include <deque>
+#include <vector>
+
+/**
+ * devector against std::vector & std::deque for the operations all three support,
+ * emulating the front ones on std::vector with insert & erase at begin().
+ */
+namespace{
+
+using namespace bench;
+
+template<class T>
+using devector = rdsl::devector<T, counting_allocator<T>>;
+
+template<class T>
+using vector = std::vector<T, counting_allocator<T>>;
+
+template<class T>
+using deque = std::deque<T, counting_allocator<T>>;
+
+template<class T> std::string name(const devector<T>&){ return std::string("devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const vector<T>&){ return std::string("std::vector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const deque<T>&){ return std::string("std::deque<") + element<T>::name() + ">"; }
+
+// std::vector's front operations are O(n), measuring them on big sizes takes ages without telling anything new.
+template<class T> bool slow_front(const vector<T>&, size_t n){ return n > 65536; }
+template<class C> bool slow_front(const C&, size_t){ return false; }
+
+template<class T> void push_front(devector<T>& c, const T& val){ c.push_front(val); }
+template<class T> void push_front(vector<T>& c, const T& val){ c.insert(c.begin(), val); }
+template<class T> void push_front(deque<T>& c, const T& val){ c.push_front(val); }
+
+template<class T> void pop_front(devector<T>& c){ c.pop_front(); }
+template<class T> void pop_front(vector<T>& c){ c.erase(c.begin()); }
+template<class T> void pop_front(deque<T>& c){ c.pop_front(); }
+
+template<class T> void resize_front(devector<T>& c, size_t n){ c.resize_front(n); }
+
+template<class C>
+void resize_front(C& c, size_t n){
+    if(n > c.size()){
+        c.insert(c.begin(), n - c.size(), typename C::value_type());
+    }else{
+        c.erase(c.begin(), c.begin() + (c.size() - n));
+    }
+}
+
+template<class T> void resize_back(devector<T>& c, size_t n){ c.resize_back(n); }
+template<class C> void resize_back(C& c, size_t n){ c.resize(n); }
+
+template<class C>
+void end_operations(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+    const std::string container = name(C());
+    const bool slow = slow_front(C(), n);
+
+    run(cfg, "containers/push_back", container, n, n, [&](state&){
+        C c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(val);
+        }
+        do_not_optimize(c);
+    });
+
+    if(!slow){
+        run(cfg, "containers/push_front", container, n, n, [&](state&){
+            C c;
+            for(size_t i = 0; i < n; ++i){
+                push_front(c, val);
+            }
+            do_not_optimize(c);
+        });
+    }
+
+    run(cfg, "containers/pop_back", container, n, n, [&](state& st){
+        st.pause();
+        C c(n, val);
+        st.resume();
+        while(!c.empty()){
+            c.pop_back();
+        }
+        do_not_optimize(c);
+    });
+
+    if(!slow){
+        run(cfg, "containers/pop_front", container, n, n, [&](state& st){
+            st.pause();
+            C c(n, val);
+            st.resume();
+            while(!c.empty()){
+                pop_front(c);
+            }
+            do_not_optimize(c);
+        });
+
+        // A queue of n elements streaming another n through it.
+        run(cfg, "containers/fifo", container, n, n, [&](state& st){
+            st.pause();
+            C c(n, val);
+            st.resume();
+            for(size_t i = 0; i < n; ++i){
+                c.push_back(val);
+                pop_front(c);
+            }
+            do_not_optimize(c);
+        });
+
+        run(cfg, "containers/resize_front", container, n, n, [&](state&){
+            C c;
+            resize_front(c, n / 2);
+            resize_front(c, n);
+            do_not_optimize(c);
+        });
+    }
+
+    run(cfg, "containers/resize_back", container, n, n, [&](state&){
+        C c;
+        resize_back(c, n / 2);
+        resize_back(c, n);
+        do_not_optimize(c);
+    });
+
+    const C src(n, val);
+
+    run(cfg, "containers/iterate", container, n, n, [&](state&){
+        size_t sum = 0;
+        for(const T& v: src){
+            sum += element<T>::weight(v);
+        }
+        do_not_optimize(sum);
+    });
+
+    run(cfg, "containers/copy_assign", container, n, n, [&](state& st){
+        st.pause();
+        C dst(n, element<T>::make(2));
+        st.resume();
+        dst = src;
+        do_not_optimize(dst);
+    });
+
+    run(cfg, "containers/move_assign", container, n, 2, [&](state& st){
+        st.pause();
+        C a(src);
+        C b;
+        st.resume();
+        b = std::move(a);
+        a = std::move(b);
+        do_not_optimize(a);
+    });
+}
+
+template<class C>
+void middle_operations(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+    const std::string container = name(C());
+    const size_t ops = 256;
+
+    run(cfg, "containers/random_insert", container, n, ops, [&](state& st){
+        st.pause();
+        C c(n, val);
+        xorshift rng;
+        st.resume();
+        for(size_t i = 0; i < ops; ++i){
+            c.insert(c.begin() + rng(c.size() + 1), val);
+        }
+        do_not_optimize(c);
+    });
+
+    run(cfg, "containers/random_erase", container, n, ops, [&](state& st){
+        st.pause();
+        C c(n + ops, val);
+        xorshift rng;
+        st.resume();
+        for(size_t i = 0; i < ops; ++i){
+            c.erase(c.begin() + rng(c.size()));
+        }
+        do_not_optimize(c);
+    });
+}
+
+template<class T>
+void all_end_operations(const config& cfg, size_t n){
+    end_operations<devector<T>>(cfg, n);
+    end_operations<vector<T>>(cfg, n);
+    end_operations<deque<T>>(cfg, n);
+}
+
+template<class T>
+void all_middle_operations(const config& cfg, size_t n){
+    middle_operations<devector<T>>(cfg, n);
+    middle_operations<vector<T>>(cfg, n);
+    middle_operations<deque<T>>(cfg, n);
+}
+
+void containers(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        all_end_operations<int>(cfg, n);
+        all_end_operations<fat>(cfg, n);
+        all_end_operations<std::string>(cfg, n);
+
+        all_middle_operations<int>(cfg, n);
+        all_middle_operations<fat>(cfg, n);
+        all_middle_operations<std::string>(cfg, n);
+    }
+}
+
+BENCH_SUITE("containers", containers);
+
+} //namespace
@@ -0,0 +1,74 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/incremental_devector.hpp"
+#include "rdsl/virtual_allocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Tail latency of push_back: every push of n is timed on its own, and the p50, p99, p99.9 & max of
+ * those are printed in the ns/op column. Growing by copying shows up as spikes proportional to the
+ * size, which incremental_devector spreads over the following pushes & virtual_devector avoids.
+ */
+namespace{
+
+using namespace bench;
+
+template<class T> using copying = rdsl::devector<T, counting_allocator<T>>;
+template<class T> using incremental = rdsl::incremental_devector<T, counting_allocator<T>>;
+template<class T> using reserved = rdsl::devector<T, rdsl::virtual_allocator<T>>;
+template<class T> using vector = std::vector<T, counting_allocator<T>>;
+
+template<class T> std::string name(const copying<T>&){ return std::string("devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const incremental<T>&){ return std::string("incremental_devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const reserved<T>&){ return std::string("virtual_devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const vector<T>&){ return std::string("std::vector<") + element<T>::name() + ">"; }
+
+template<class C>
+void push_back(const config& cfg, size_t n){
+    using clock = std::chrono::steady_clock;
+    using T = typename C::value_type;
+
+    const std::string container = name(C());
+    if(n > cfg.max_size || !cfg.selected("latency/push_back")){
+        return;
+    }
+
+    const T val = element<T>::make(1);
+    std::vector<long long> samples(n);
+    stats().reset();
+    {
+        C c;
+        for(size_t i = 0; i < n; ++i){
+            const clock::time_point start = clock::now();
+            c.push_back(val);
+            samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        }
+        do_not_optimize(c);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const double allocations = double(stats().allocations);
+    print({"latency/push_back_p50", container, n, double(samples[n / 2]), allocations, stats().peak, 0});
+    print({"latency/push_back_p99", container, n, double(samples[n / 100 * 99]), allocations, stats().peak, 0});
+    print({"latency/push_back_p99.9", container, n, double(samples[n / 1000 * 999]), allocations, stats().peak, 0});
+    print({"latency/push_back_max", container, n, double(samples.back()), allocations, stats().peak, 0});
+}
+
+void latency(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        if(n < 4096){
+            continue;
+        }
+
+        push_back<vector<int>>(cfg, n);
+        push_back<copying<int>>(cfg, n);
+        push_back<reserved<int>>(cfg, n);
+        push_back<incremental<int>>(cfg, n);
+    }
+}
+
+BENCH_SUITE("latency", latency);
+
+} //namespace
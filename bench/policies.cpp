@@ -0,0 +1,142 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+
+/**
+ * The effect of devector's policies: relocation, where begin is placed & how capacity grows.
+ */
+namespace{
+
+using namespace bench;
+
+// As big as a fat, but with a move constructor of its own, so it's neither trivially copyable nor relocatable.
+struct non_trivial{
+    non_trivial(unsigned char c = 0) noexcept{
+        std::fill(f.bytes, f.bytes + sizeof(f.bytes), c);
+    }
+
+    non_trivial(const non_trivial& x) noexcept
+    :f(x.f) {}
+
+    non_trivial& operator=(const non_trivial& x) noexcept{
+        f = x.f;
+        return *this;
+    }
+
+    fat f;
+};
+
+template<class T>
+void relocation(const config& cfg, size_t n, const std::string& container){
+    using devector = rdsl::devector<T, counting_allocator<T>>;
+    const T val = T();
+
+    run(cfg, "policies/relocation/push_back", container, n, n, [&](state&){
+        devector c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(val);
+        }
+        do_not_optimize(c);
+    });
+
+    run(cfg, "policies/relocation/push_front", container, n, n, [&](state&){
+        devector c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_front(val);
+        }
+        do_not_optimize(c);
+    });
+
+    run(cfg, "policies/relocation/shrink_to_fit", container, n, n, [&](state& st){
+        st.pause();
+        devector c(n, val);
+        c.reserve(2 * n);
+        st.resume();
+        c.shrink_to_fit();
+        do_not_optimize(c);
+    });
+}
+
+// Pushes n elements, *front_percent* of them at the front, then pops them back off the same ends.
+template<class OffsetBy>
+void offsets(const config& cfg, size_t n, const std::string& container, size_t front_percent){
+    using devector = rdsl::devector<int, counting_allocator<int>, OffsetBy>;
+    const std::string name = "policies/offset/front" + std::to_string(front_percent) + "%";
+
+    run(cfg, name, container, n, 2 * n, [&](state&){
+        devector c;
+        xorshift rng;
+        for(size_t i = 0; i < n; ++i){
+            if(rng(100) < front_percent){
+                c.push_front(static_cast<int>(i));
+            }else{
+                c.push_back(static_cast<int>(i));
+            }
+        }
+        for(size_t i = 0; i < n; ++i){
+            if(rng(100) < front_percent){
+                c.pop_front();
+            }else{
+                c.pop_back();
+            }
+        }
+        do_not_optimize(c);
+    });
+}
+
+// Throughput of push_back against the memory it leaves behind, for a growth policy.
+template<class GrowthPolicy>
+void growth(const config& cfg, size_t n, const std::string& container){
+    using devector = rdsl::devector<int, counting_allocator<int>, rdsl::offset_by, GrowthPolicy>;
+
+    run(cfg, "policies/growth/push_back", container, n, n, [&](state&){
+        devector c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(static_cast<int>(i));
+        }
+        do_not_optimize(c);
+    });
+}
+
+// A queue's burst: n pushes at the back, drained from the front down to 1%, with & without giving memory back.
+template<class GrowthPolicy>
+void shrink(const config& cfg, size_t n, const std::string& container){
+    using devector = rdsl::devector<int, counting_allocator<int>, rdsl::offset_by, GrowthPolicy>;
+
+    run(cfg, "policies/shrink/burst", container, n, 2 * n, [&](state&){
+        devector c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(static_cast<int>(i));
+        }
+        while(c.size() > n / 100){
+            c.pop_front();
+        }
+        do_not_optimize(c);
+    });
+}
+
+void policies(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        relocation<fat>(cfg, n, "relocatable fat64");
+        relocation<non_trivial>(cfg, n, "non relocatable fat64");
+
+        for(size_t front_percent: {5, 50}){
+            offsets<rdsl::offset_by>(cfg, n, "offset_by", front_percent);
+            offsets<rdsl::adaptive_offset_by>(cfg, n, "adaptive_offset_by", front_percent);
+        }
+
+        growth<rdsl::geometric_growth<>>(cfg, n, "geometric_growth<8, 5>");
+        growth<rdsl::geometric_growth<2, 1>>(cfg, n, "geometric_growth<2, 1>");
+        growth<rdsl::geometric_growth<5, 4>>(cfg, n, "geometric_growth<5, 4>");
+        growth<rdsl::power_of_two_growth>(cfg, n, "power_of_two_growth");
+        if(n <= size_t(1) << 20){ // quadratic beyond that
+            growth<rdsl::chunked_growth<4096>>(cfg, n, "chunked_growth<4096>");
+        }
+
+        shrink<rdsl::geometric_growth<>>(cfg, n, "geometric_growth<8, 5>");
+        shrink<rdsl::hysteresis_shrink<>>(cfg, n, "hysteresis_shrink<>");
+    }
+}
+
+BENCH_SUITE("policies", policies);
+
+} //namespace
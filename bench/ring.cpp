@@ -0,0 +1,57 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/ring_devector.hpp"
+
+#include <deque>
+
+/**
+ * Queues: a stream of push_back & pop_front through ring_devector, devector & std::deque.
+ */
+namespace{
+
+using namespace bench;
+
+template<class T> std::string name(const rdsl::ring_devector<T, counting_allocator<T>>&){ return std::string("ring_devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const rdsl::devector<T, counting_allocator<T>>&){ return std::string("devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const std::deque<T, counting_allocator<T>>&){ return std::string("std::deque<") + element<T>::name() + ">"; }
+
+// Keeps *depth* elements queued while n more stream through.
+template<class C>
+void stream(const config& cfg, size_t n, size_t depth){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+    const std::string name_ = "ring/stream/depth" + std::to_string(depth);
+
+    run(cfg, name_, name(C()), n, n, [&](state&){
+        C c;
+        for(size_t i = 0; i < depth; ++i){
+            c.push_back(val);
+        }
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(val);
+            c.pop_front();
+        }
+        do_not_optimize(c);
+    });
+}
+
+template<class T>
+void all_streams(const config& cfg, size_t n){
+    for(size_t depth: {16, 1024}){
+        stream<rdsl::ring_devector<T, counting_allocator<T>>>(cfg, n, depth);
+        stream<rdsl::devector<T, counting_allocator<T>>>(cfg, n, depth);
+        stream<std::deque<T, counting_allocator<T>>>(cfg, n, depth);
+    }
+}
+
+void ring(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        all_streams<int>(cfg, n);
+        all_streams<fat>(cfg, n);
+        all_streams<std::string>(cfg, n);
+    }
+}
+
+BENCH_SUITE("ring", ring);
+
+} //namespace
@@ -0,0 +1,116 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/aligned_allocator.hpp"
+
+#include <cstdint>
+
+/**
+ * Vectorizable loops over devectors whose begin() is or isn't aligned to a cache line.
+ * Build with DEVECTOR_BENCH_NATIVE to let the compiler use AVX2 & friends.
+ */
+namespace{
+
+using namespace bench;
+
+constexpr size_t alignment = 64;
+
+template<class T>
+using aligned = rdsl::devector<T, rdsl::aligned_allocator<T, alignment>, rdsl::aligned_offset_by<T, alignment>>;
+
+template<class T>
+using huge = rdsl::devector<T, rdsl::aligned_allocator<T, alignment, true>, rdsl::aligned_offset_by<T, alignment>>;
+
+template<class T>
+using plain = rdsl::devector<T>;
+
+template<bool Aligned>
+const float* assume_aligned(const float* p){
+#if defined(__GNUC__)
+    return Aligned ? static_cast<const float*>(__builtin_assume_aligned(p, alignment)) : p;
+#else
+    return p;
+#endif
+}
+
+template<bool Aligned>
+float* assume_aligned(float* p){
+    return const_cast<float*>(assume_aligned<Aligned>(static_cast<const float*>(p)));
+}
+
+template<bool Aligned>
+std::int32_t sum(const std::int32_t* p, size_t n){
+#if defined(__GNUC__)
+    if(Aligned){
+        p = static_cast<const std::int32_t*>(__builtin_assume_aligned(p, alignment));
+    }
+#endif
+    std::int32_t s = 0;
+    for(size_t i = 0; i < n; ++i){
+        s += p[i];
+    }
+    return s;
+}
+
+template<bool Aligned>
+void transform(const float* in, float* out, size_t n){
+    in = assume_aligned<Aligned>(in);
+    out = assume_aligned<Aligned>(out);
+    for(size_t i = 0; i < n; ++i){
+        out[i] = in[i] * 1.5f + 2.0f;
+    }
+}
+
+template<class C>
+std::string describe(const std::string& name, const C& c){
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(&*c.begin()) % alignment;
+    return name + " @" + std::to_string(misalignment);
+}
+
+// Pushes at both ends then reallocates, so begin() ends up wherever the offset policy puts it.
+// Pushes at the front move begin() an element at a time, only the layouts devector picks itself are aligned.
+template<class C>
+C make(size_t n){
+    C c;
+    for(size_t i = 0; i < n; ++i){
+        if(i % 3){
+            c.push_back(typename C::value_type(i % 7));
+        }else{
+            c.push_front(typename C::value_type(i % 7));
+        }
+    }
+    c.reserve(c.capacity() + 100);
+    return c;
+}
+
+template<class Ints, class Floats, bool Aligned>
+void kernels(const config& cfg, size_t n, const std::string& name){
+    const Ints ints = make<Ints>(n);
+    const Floats in = make<Floats>(n);
+    Floats out = make<Floats>(n);
+
+    run(cfg, "simd/sum_i32", describe(name, ints), n, n, [&](state&){
+        do_not_optimize(sum<Aligned>(&*ints.begin(), ints.size()));
+    });
+
+    run(cfg, "simd/transform_f32", describe(name, out), n, n, [&](state&){
+        transform<Aligned>(&*in.begin(), &*out.begin(), n);
+        do_not_optimize(out);
+    });
+}
+
+void simd(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        if(n < 256){
+            continue;
+        }
+
+        kernels<plain<std::int32_t>, plain<float>, false>(cfg, n, "devector");
+        kernels<aligned<std::int32_t>, aligned<float>, false>(cfg, n, "aligned");
+        kernels<aligned<std::int32_t>, aligned<float>, true>(cfg, n, "aligned, assumed");
+        kernels<huge<std::int32_t>, huge<float>, true>(cfg, n, "huge pages, assumed");
+    }
+}
+
+BENCH_SUITE("simd", simd);
+
+} //namespace
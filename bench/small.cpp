@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/small_devector.hpp"
+
+/**
+ * Short sequences: many containers of a handful of elements each, built, worked on & torn down,
+ * through small_devector, devector & std::vector.
+ */
+namespace{
+
+using namespace bench;
+
+constexpr size_t inline_capacity = 16;
+
+template<class T> using small = rdsl::small_devector<T, inline_capacity, counting_allocator<T>>;
+
+template<class T> std::string name(const small<T>&){ return std::string("small_devector<") + element<T>::name() + ",16>"; }
+template<class T> std::string name(const rdsl::devector<T, counting_allocator<T>>&){ return std::string("devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const std::vector<T, counting_allocator<T>>&){ return std::string("std::vector<") + element<T>::name() + ">"; }
+
+// n containers, each filled with *length* elements at the back & drained from the front.
+template<class C>
+void fill_drain(const config& cfg, size_t n, size_t length){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+    const std::string name_ = "small/fill_drain/length" + std::to_string(length);
+
+    run(cfg, name_, name(C()), n, n * length, [&](state&){
+        for(size_t i = 0; i < n; ++i){
+            C c;
+            for(size_t j = 0; j < length; ++j){
+                c.push_back(val);
+            }
+            while(!c.empty()){
+                c.erase(c.begin());
+            }
+            do_not_optimize(c);
+        }
+    });
+}
+
+// n containers of *length* elements copied one after the other, the way values of such a type get passed around.
+template<class C>
+void copy(const config& cfg, size_t n, size_t length){
+    using T = typename C::value_type;
+    const std::string name_ = "small/copy/length" + std::to_string(length);
+
+    C source;
+    for(size_t j = 0; j < length; ++j){
+        source.push_back(element<T>::make(j));
+    }
+
+    run(cfg, name_, name(C()), n, n, [&](state&){
+        for(size_t i = 0; i < n; ++i){
+            C c(source);
+            do_not_optimize(c);
+        }
+    });
+}
+
+template<class T>
+void all_short(const config& cfg, size_t n){
+    for(size_t length: {size_t(4), inline_capacity, 4 * inline_capacity}){
+        fill_drain<small<T>>(cfg, n, length);
+        fill_drain<rdsl::devector<T, counting_allocator<T>>>(cfg, n, length);
+        fill_drain<std::vector<T, counting_allocator<T>>>(cfg, n, length);
+
+        copy<small<T>>(cfg, n, length);
+        copy<rdsl::devector<T, counting_allocator<T>>>(cfg, n, length);
+        copy<std::vector<T, counting_allocator<T>>>(cfg, n, length);
+    }
+}
+
+void small_sequences(const config& cfg){
+    for(size_t n: sizes(cfg)){
+        all_short<int>(cfg, n);
+        all_short<std::string>(cfg, n);
+    }
+}
+
+BENCH_SUITE("small", small_sequences);
+
+} //namespace
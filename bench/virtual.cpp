@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "rdsl/devector.hpp"
+#include "rdsl/virtual_allocator.hpp"
+
+/**
+ * Growth: a devector pushed to n elements, up to 10^9, copying itself into each new buffer
+ * against one on a virtual_allocator, committing more of its reservation instead.
+ * The latter doesn't go through counting_allocator, its allocation columns stay empty.
+ */
+namespace{
+
+using namespace bench;
+
+template<class T> using copying = rdsl::devector<T, counting_allocator<T>>;
+template<class T> using reserved = rdsl::devector<T, rdsl::virtual_allocator<T>>;
+
+template<class T> std::string name(const copying<T>&){ return std::string("devector<") + element<T>::name() + ">"; }
+template<class T> std::string name(const reserved<T>&){ return std::string("virtual_devector<") + element<T>::name() + ">"; }
+
+template<class C>
+void push_back(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+
+    run(cfg, "virtual/grow/push_back", name(C()), n, n, [&](state&){
+        C c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_back(val);
+        }
+        do_not_optimize(c);
+    });
+}
+
+template<class C>
+void push_front(const config& cfg, size_t n){
+    using T = typename C::value_type;
+    const T val = element<T>::make(1);
+
+    run(cfg, "virtual/grow/push_front", name(C()), n, n, [&](state&){
+        C c;
+        for(size_t i = 0; i < n; ++i){
+            c.push_front(val);
+        }
+        do_not_optimize(c);
+    });
+}
+
+template<class T>
+void all_growth(const config& cfg, size_t n){
+    push_back<copying<T>>(cfg, n);
+    push_back<reserved<T>>(cfg, n);
+    push_front<copying<T>>(cfg, n);
+    push_front<reserved<T>>(cfg, n);
+}
+
+void virtual_growth(const config& cfg){
+    std::vector<size_t> all = sizes(cfg);
+    if(cfg.max_size >= size_t(1000000000)){
+        all.push_back(1000000000);
+    }
+
+    for(size_t n: all){
+        all_growth<int>(cfg, n);
+    }
+}
+
+BENCH_SUITE("virtual", virtual_growth);
+
+} //namespace
@@ -0,0 +1,160 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * aligned_allocator.hpp 0.0.0
+ *
+ * A header-only over-aligning, optionally huge page backed allocator & an offset policy keeping begin() aligned.
+ */
+
+#ifndef ALIGNED_ALLOCATOR_RDSL_17102026
+#define ALIGNED_ALLOCATOR_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace rdsl{
+
+constexpr size_t huge_page_size = size_t(2) << 20;
+
+/**
+ * @brief Allocates blocks aligned to *Alignment* bytes, a power of two, e.g. cache_line_size or a page.
+ *
+ * With *HugePages*, blocks of at least huge_page_size bytes are aligned to it and, on Linux, advised
+ * to be backed by transparent huge pages, cutting TLB misses when streaming through big arrays.
+ */
+template<class T, size_t Alignment = cache_line_size, bool HugePages = false>
+struct aligned_allocator{
+    static_assert(Alignment && !(Alignment & (Alignment - 1)), "aligned_allocator needs a power of two alignment");
+    static_assert(Alignment >= alignof(T), "aligned_allocator can't align less than T requires");
+
+    using value_type = T;
+    using size_type = size_t;
+
+    template<class U>
+    struct rebind{
+        using other = aligned_allocator<U, Alignment, HugePages>;
+    };
+
+    // posix_memalign takes no less than a pointer's alignment.
+    static constexpr size_t alignment() noexcept{
+        return Alignment < sizeof(void*) ? sizeof(void*) : Alignment;
+    }
+
+    aligned_allocator() noexcept = default;
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment, HugePages>&) noexcept {}
+
+    T* allocate(size_type n){
+        if(n > max_size()){
+            throw std::bad_alloc();
+        }
+
+        const size_t bytes = n * sizeof(T);
+        const bool huge = HugePages && bytes >= huge_page_size;
+        const size_t align = huge && huge_page_size > alignment() ? huge_page_size : alignment();
+
+        void* p;
+#if defined(_WIN32)
+        p = ::_aligned_malloc(bytes ? bytes : 1, align);
+        if(!p){
+            throw std::bad_alloc();
+        }
+#else
+        if(::posix_memalign(&p, align, bytes ? bytes : 1)){
+            throw std::bad_alloc();
+        }
+#if defined(MADV_HUGEPAGE)
+        if(huge){
+            ::madvise(p, bytes, MADV_HUGEPAGE); // only a hint, failing changes nothing
+        }
+#endif
+#endif
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_type) noexcept{
+#if defined(_WIN32)
+        ::_aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    size_type max_size() const noexcept{
+        return size_type(-1) / sizeof(T);
+    }
+
+    template<class U>
+    bool operator==(const aligned_allocator<U, Alignment, HugePages>&) const noexcept{ return true; }
+
+    template<class U>
+    bool operator!=(const aligned_allocator<U, Alignment, HugePages>&) const noexcept{ return false; }
+};
+
+/**
+ * @brief Rounds the offset *OffsetBy* picks down, so that *begin* lies a multiple of *Alignment* bytes
+ * away from the start of the array. Paired with an aligned_allocator of the same alignment, begin()
+ * is then always aligned & vectorized loops over it need no scalar prologue.
+ *
+ * Recentering and the usage notifications are inherited from *OffsetBy*.
+ */
+template<class T, size_t Alignment = cache_line_size, class OffsetBy = rdsl::offset_by>
+struct aligned_offset_by: public OffsetBy{
+    aligned_offset_by(const OffsetBy& offs = OffsetBy())
+    :OffsetBy(offs) {}
+
+    // The number of elements between two aligned addresses.
+    static constexpr size_t step() noexcept{
+        return Alignment / gcd(Alignment, sizeof(T));
+    }
+
+    size_t off_by(const offset_context& context){
+        const size_t offset = offset_by_traits<OffsetBy>::off_by(*this, context);
+        return offset - offset % step();
+    }
+
+    // Opening a gap at the front moves begin by the gap's size, which would misalign it.
+    static constexpr bool shift_shorter_side() noexcept{
+        return false;
+    }
+
+private:
+    static constexpr size_t gcd(size_t a, size_t b) noexcept{
+        return b ? gcd(b, a % b) : a;
+    }
+};
+} //rdsl
+
+#endif
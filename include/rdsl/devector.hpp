@@ -32,9 +32,33 @@
 #ifndef DEVECTOR_RDSL_28092021
 #define DEVECTOR_RDSL_28092021
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <iterator>
+#include <type_traits>
+#include <cstring>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// Comparisons & searches over integers run on SSE2, or AVX2 when the CPU running them has it. DEVECTOR_NO_SIMD turns them off.
+#if !defined(DEVECTOR_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)))
+#define DEVECTOR_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define DEVECTOR_SIMD_AVX2
+#define DEVECTOR_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define DEVECTOR_SIMD_AVX2
+#define DEVECTOR_TARGET_AVX2
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
 
 namespace rdsl{
 
@@ -44,6 +68,9 @@ using al_traits = std::allocator_traits<al>;
 template<class it>
 using it_traits = std::iterator_traits<it>;
 
+// Used to keep data written by different threads apart, avoiding false sharing.
+constexpr size_t cache_line_size = 64;
+
 template<class It>
 struct is_at_least_forward{
     static constexpr bool value = false;
@@ -85,184 +112,1114 @@ using enable_if_t = std::enable_if_t<B, T>;
 template<class It>
 using is_iterator = enable_if_t<is_at_least_input<typename it_traits<It>::iterator_category>::value, int>;
 
-struct offset_by{
-    static size_t off_by(size_t free_blocks) noexcept{
-        return free_blocks / 2;
-    }
-};
+/**
+ * @brief Whether the number of elements in Range is known before iterating it, either through a size() member or forward iterators.
+ */
+template<class Range>
+struct is_sized_range{
+private:
+    template<class R>
+    static auto test(int) -> decltype(std::declval<const R&>().size(), std::true_type());
 
-template<typename T, class Alloc = std::allocator<T>, class OffsetBy = rdsl::offset_by>
-struct devector{
-    using value_type = T;
-    using allocator_type = Alloc;
-    using offset_by_type = OffsetBy;
-    using reference = value_type&;
-    using const_reference = const value_type&;
-    using pointer = typename al_traits<allocator_type>::pointer;
-    using const_pointer = typename al_traits<allocator_type>::const_pointer;
-    using size_type = typename al_traits<allocator_type>::size_type;
-    using difference_type = typename al_traits<allocator_type>::difference_type;
-    using iterator = pointer;
-    using const_iterator = const_pointer;
-    using reverse_iterator = std::reverse_iterator<iterator>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    template<class R>
+    static is_at_least_forward<typename it_traits<decltype(std::begin(std::declval<R&>()))>::iterator_category> test(long);
 
-private:
-    struct compressed_alloc: public allocator_type{
-        compressed_alloc(const allocator_type& alloc = allocator_type())
-        :allocator_type(alloc)
-        {}
+public:
+    static constexpr bool value = decltype(test<typename std::remove_reference<Range>::type>(0))::value;
+};
 
-        compressed_alloc(const compressed_alloc&) = delete;
-        compressed_alloc(compressed_alloc&&) noexcept = delete;
-        compressed_alloc& operator=(const compressed_alloc&) = delete;
-        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+/**
+ * @brief Whether an object of type T may be moved to a new address by copying its bytes,
+ * without calling its move constructor and destructor. Specialize it for types such as
+ * std::unique_ptr to let devector shift and reallocate them using memmove.
+ */
+template<class T>
+struct is_trivially_relocatable: std::is_trivially_copyable<T> {};
 
-        allocator_type& get() noexcept{ return *this; }
-        const allocator_type& get() const noexcept{ return *this; }
+/**
+ * @brief Whether two objects of type T are equal exactly when their bytes are, which lets ranges of them be compared
+ * & searched a vector register at a time. Holds for integers, enums & pointers but not floating point, where NaN != NaN
+ * and 0.0 == -0.0. Specialize it for types without padding whose operator== compares every member.
+ */
+template<class T>
+struct is_byte_comparable: std::integral_constant<bool,
+    std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value
+> {};
 
-        pointer arr;
-    }alloc;
+namespace simd{
 
-    struct compressed_offs: public offset_by_type{
-        compressed_offs(const offset_by_type& offs = offset_by_type())
-        :offset_by_type(offs)
-        {}
+enum class isa{ scalar, sse2, avx2 };
 
-        compressed_offs(const compressed_offs&) = delete;
-        compressed_offs(compressed_offs&&) noexcept = delete;
-        compressed_offs& operator=(const compressed_offs&) = delete;
-        compressed_offs& operator=(compressed_offs&&) noexcept = delete;
+/**
+ * @brief The widest instruction set the kernels below may use on this CPU.
+ */
+inline isa detect() noexcept{
+#if defined(DEVECTOR_SIMD_AVX2) && defined(__GNUC__)
+    return __builtin_cpu_supports("avx2") ? isa::avx2 : isa::sse2;
+#elif defined(DEVECTOR_SIMD_AVX2)
+    return isa::avx2;
+#elif defined(DEVECTOR_SIMD_SSE2)
+    return isa::sse2;
+#else
+    return isa::scalar;
+#endif
+}
 
-        offset_by_type& get() noexcept{ return *this; }
-        const offset_by_type& get() const noexcept{ return *this; }
+// Detected once, the first time a kernel runs.
+inline isa supported() noexcept{
+    static const isa level = detect();
+    return level;
+}
 
-        size_type capacity;
-    }offs;
+#if defined(DEVECTOR_SIMD_SSE2)
+inline unsigned first_bit(std::uint32_t mask) noexcept{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
 
-    pointer begin_;
-    pointer end_;
+template<size_t Width>
+using lane_width = std::integral_constant<size_t, Width>;
 
-    static constexpr float factor = 1.6f; // new_capacity = capacity * factor
+// The bytes left over after the last whole register, handled one by one.
+inline size_t mismatch_tail(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+    size_t i = 0;
+    while(i < n && a[i] == b[i]){
+        ++i;
+    }
+    return i;
+}
 
-    struct buffer_guard{
-        pointer begin;
-        pointer end;
-        allocator_type& alloc;
+template<size_t Width>
+size_t find_tail(const unsigned char* p, size_t n, const unsigned char* value) noexcept{
+    for(size_t i = 0; i < n; i += Width){
+        if(!std::memcmp(p + i, value, Width)){
+            return i;
+        }
+    }
+    return n;
+}
 
-        buffer_guard(allocator_type& alloc, pointer begin, pointer end)
-        :alloc(alloc), begin(begin), end(end) {}
+template<size_t Width>
+size_t count_tail(const unsigned char* p, size_t n, const unsigned char* value) noexcept{
+    size_t count = 0;
+    for(size_t i = 0; i < n; i += Width){
+        count += !std::memcmp(p + i, value, Width);
+    }
+    return count;
+}
 
-        buffer_guard(allocator_type& alloc, pointer start)
-        :alloc(alloc), begin(start), end(start) {}
+/**
+ * Kernels over *n* bytes. find & count look for *Width* byte values, *pattern* holding one repeated over a register,
+ * and return a byte offset & a count of values respectively.
+ *
+ * count subtracts every all ones lane from per byte counters, so each match adds *Width* to them, and sums those
+ * up before any of them can overflow.
+ */
+namespace sse2{
+inline __m128i equal_lanes(__m128i x, __m128i y, lane_width<1>) noexcept{ return _mm_cmpeq_epi8(x, y); }
+inline __m128i equal_lanes(__m128i x, __m128i y, lane_width<2>) noexcept{ return _mm_cmpeq_epi16(x, y); }
+inline __m128i equal_lanes(__m128i x, __m128i y, lane_width<4>) noexcept{ return _mm_cmpeq_epi32(x, y); }
+
+// SSE2 can't compare 64 bit lanes, both of their halves have to be equal.
+inline __m128i equal_lanes(__m128i x, __m128i y, lane_width<8>) noexcept{
+    const __m128i halves = _mm_cmpeq_epi32(x, y);
+    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+}
 
-        buffer_guard(allocator_type& alloc)
-        :alloc(alloc), begin(nullptr), end(nullptr) {}
+inline __m128i load(const unsigned char* p) noexcept{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
 
-        void guard(pointer begin, pointer end){
-            this->begin = begin;
-            this->end = end;
+inline size_t mismatch(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16){
+        const std::uint32_t differ = ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(load(a + i), load(b + i)))) & 0xFFFF;
+        if(differ){
+            return i + first_bit(differ);
         }
+    }
+    return i + mismatch_tail(a + i, b + i, n - i);
+}
 
-        void guard(pointer start){
-            begin = end = start;
+template<size_t Width>
+size_t find(const unsigned char* p, size_t n, const unsigned char* pattern) noexcept{
+    const __m128i value = load(pattern);
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16){
+        const std::uint32_t match = _mm_movemask_epi8(equal_lanes(load(p + i), value, lane_width<Width>()));
+        if(match){
+            return i + first_bit(match);
         }
+    }
+    return i + find_tail<Width>(p + i, n - i, pattern);
+}
 
-        void release(){
-            begin = end;
+template<size_t Width>
+size_t count(const unsigned char* p, size_t n, const unsigned char* pattern) noexcept{
+    const __m128i value = load(pattern);
+    size_t bytes = 0, i = 0;
+    while(i + 16 <= n){
+        __m128i counters = _mm_setzero_si128();
+        for(size_t rounds = 0; rounds < 255 && i + 16 <= n; ++rounds, i += 16){
+            counters = _mm_sub_epi8(counters, equal_lanes(load(p + i), value, lane_width<Width>()));
         }
 
-        ~buffer_guard(){
-            while(begin != end){
-                al_traits<allocator_type>::destroy(alloc, begin);
-                ++begin;
-            }
-        }
-    };
+        const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        bytes += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums));
+    }
+    return bytes / Width + count_tail<Width>(p + i, n - i, pattern);
+}
+} //sse2
 
-    struct memory_guard{
-        pointer arr;
-        size_type capacity;
-        allocator_type& alloc;
+#if defined(DEVECTOR_SIMD_AVX2)
+namespace avx2{
+DEVECTOR_TARGET_AVX2 inline __m256i equal_lanes(__m256i x, __m256i y, lane_width<1>) noexcept{ return _mm256_cmpeq_epi8(x, y); }
+DEVECTOR_TARGET_AVX2 inline __m256i equal_lanes(__m256i x, __m256i y, lane_width<2>) noexcept{ return _mm256_cmpeq_epi16(x, y); }
+DEVECTOR_TARGET_AVX2 inline __m256i equal_lanes(__m256i x, __m256i y, lane_width<4>) noexcept{ return _mm256_cmpeq_epi32(x, y); }
+DEVECTOR_TARGET_AVX2 inline __m256i equal_lanes(__m256i x, __m256i y, lane_width<8>) noexcept{ return _mm256_cmpeq_epi64(x, y); }
 
-        memory_guard(allocator_type& alloc, size_type capacity)
-        :alloc(alloc), capacity(capacity), arr(alloc.allocate(capacity)) {}
+DEVECTOR_TARGET_AVX2 inline __m256i load(const unsigned char* p) noexcept{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
 
-        void release(){
-            arr = nullptr;
+DEVECTOR_TARGET_AVX2 inline size_t mismatch(const unsigned char* a, const unsigned char* b, size_t n) noexcept{
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32){
+        const std::uint32_t differ = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(load(a + i), load(b + i))));
+        if(differ){
+            return i + first_bit(differ);
         }
+    }
+    return i + sse2::mismatch(a + i, b + i, n - i);
+}
 
-        ~memory_guard(){
-            if(arr){
-                alloc.deallocate(arr, capacity);
-            }
+template<size_t Width>
+DEVECTOR_TARGET_AVX2 size_t find(const unsigned char* p, size_t n, const unsigned char* pattern) noexcept{
+    const __m256i value = load(pattern);
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32){
+        const std::uint32_t match = _mm256_movemask_epi8(equal_lanes(load(p + i), value, lane_width<Width>()));
+        if(match){
+            return i + first_bit(match);
         }
-    };
+    }
+    return i + sse2::find<Width>(p + i, n - i, pattern);
+}
 
-public:
+template<size_t Width>
+DEVECTOR_TARGET_AVX2 size_t count(const unsigned char* p, size_t n, const unsigned char* pattern) noexcept{
+    const __m256i value = load(pattern);
+    size_t bytes = 0, i = 0;
+    while(i + 32 <= n){
+        __m256i counters = _mm256_setzero_si256();
+        for(size_t rounds = 0; rounds < 255 && i + 32 <= n; ++rounds, i += 32){
+            counters = _mm256_sub_epi8(counters, equal_lanes(load(p + i), value, lane_width<Width>()));
+        }
 
-    size_type capacity() const noexcept{
-        return offs.capacity;
+        const __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        bytes += _mm_cvtsi128_si32(halves) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(halves, halves));
     }
+    return bytes / Width + sse2::count<Width>(p + i, n - i, pattern);
+}
+} //avx2
+#endif
 
-    size_type max_size() const{
-        return al_traits<allocator_type>::max_size(alloc);
+/**
+ * @brief *value*'s bytes repeated over the widest register the kernels use.
+ */
+template<class T>
+struct pattern{
+    unsigned char bytes[32];
+
+    explicit pattern(const T& value) noexcept{
+        for(size_t i = 0; i < sizeof(bytes); i += sizeof(T)){
+            std::memcpy(bytes + i, &value, sizeof(T));
+        }
     }
+};
+#endif
 
-    iterator begin() noexcept{
-        return begin_;
+// Ranges behind raw pointers to byte comparable elements are compared in vector registers.
+template<class Iterator>
+using compare_tag = std::integral_constant<bool,
+    std::is_pointer<Iterator>::value && is_byte_comparable<typename it_traits<Iterator>::value_type>::value
+>;
+
+// Searching also needs every element to fill whole lanes of a register.
+template<class Iterator>
+using search_tag = std::integral_constant<bool,
+    compare_tag<Iterator>::value && sizeof(typename it_traits<Iterator>::value_type) <= 8 &&
+    !(sizeof(typename it_traits<Iterator>::value_type) & (sizeof(typename it_traits<Iterator>::value_type) - 1))
+>;
+
+/**
+ * @brief The index of the first of *n* elements where *a* & *b* differ, *n* if there is none.
+ */
+template<class T>
+size_t mismatch(const T* a, const T* b, size_t n) noexcept{
+#if defined(DEVECTOR_SIMD_SSE2)
+    const unsigned char* const x = reinterpret_cast<const unsigned char*>(a);
+    const unsigned char* const y = reinterpret_cast<const unsigned char*>(b);
+#if defined(DEVECTOR_SIMD_AVX2)
+    if(supported() == isa::avx2){
+        return avx2::mismatch(x, y, n * sizeof(T)) / sizeof(T);
     }
+#endif
+    return sse2::mismatch(x, y, n * sizeof(T)) / sizeof(T);
+#else
+    return std::mismatch(a, a + n, b).first - a;
+#endif
+}
 
-    const_iterator begin() const noexcept{
-        return begin_;
+template<class T>
+size_t find(const T* p, size_t n, const T& value) noexcept{
+#if defined(DEVECTOR_SIMD_SSE2)
+    const unsigned char* const x = reinterpret_cast<const unsigned char*>(p);
+    const pattern<T> repeated(value);
+#if defined(DEVECTOR_SIMD_AVX2)
+    if(supported() == isa::avx2){
+        return avx2::find<sizeof(T)>(x, n * sizeof(T), repeated.bytes) / sizeof(T);
     }
+#endif
+    return sse2::find<sizeof(T)>(x, n * sizeof(T), repeated.bytes) / sizeof(T);
+#else
+    return std::find(p, p + n, value) - p;
+#endif
+}
 
-    iterator end() noexcept{
-        return end_;
+template<class T>
+size_t count(const T* p, size_t n, const T& value) noexcept{
+#if defined(DEVECTOR_SIMD_SSE2)
+    const unsigned char* const x = reinterpret_cast<const unsigned char*>(p);
+    const pattern<T> repeated(value);
+#if defined(DEVECTOR_SIMD_AVX2)
+    if(supported() == isa::avx2){
+        return avx2::count<sizeof(T)>(x, n * sizeof(T), repeated.bytes);
     }
+#endif
+    return sse2::count<sizeof(T)>(x, n * sizeof(T), repeated.bytes);
+#else
+    return std::count(p, p + n, value);
+#endif
+}
 
-    const_iterator end() const noexcept{
-        return end_;
+template<class Iterator>
+bool equal(Iterator first0, Iterator first1, size_t n, std::true_type){
+    return mismatch(first0, first1, n) == n;
+}
+
+template<class Iterator>
+bool equal(Iterator first0, Iterator first1, size_t n, std::false_type){
+    for(; n; --n, ++first0, ++first1){
+        if(*first0 != *first1){
+            return false;
+        }
     }
+    return true;
+}
 
-    reverse_iterator rbegin() noexcept{
-        return reverse_iterator(end_);
+/**
+ * @brief Whether the *n* elements from *first0* equal the *n* ones from *first1*.
+ */
+template<class Iterator>
+bool equal(Iterator first0, Iterator first1, size_t n){
+    return equal(first0, first1, n, compare_tag<Iterator>());
+}
+
+template<class Iterator>
+bool less(Iterator first0, size_t n0, Iterator first1, size_t n1, std::true_type){
+    const size_t n = n0 < n1 ? n0 : n1;
+    const size_t i = mismatch(first0, first1, n);
+    return i == n ? n0 < n1 : first0[i] < first1[i];
+}
+
+template<class Iterator>
+bool less(Iterator first0, size_t n0, Iterator first1, size_t n1, std::false_type){
+    for(; n0; --n0, --n1, ++first0, ++first1){
+        if(!n1 || *first1 < *first0){
+            return false;
+        }else if(*first0 < *first1){
+            return true;
+        }
     }
+    return n1 != 0;
+}
 
-    const_reverse_iterator rbegin() const noexcept{
-        return const_reverse_iterator(end_);
+/**
+ * @brief Whether the *n0* elements from *first0* compare lexicographically less than the *n1* ones from *first1*.
+ */
+template<class Iterator>
+bool less(Iterator first0, size_t n0, Iterator first1, size_t n1){
+    return less(first0, n0, first1, n1, compare_tag<Iterator>());
+}
+
+template<class Iterator, class T>
+size_t find(Iterator first, size_t n, const T& value, std::true_type){
+    return find(&*first, n, value);
+}
+
+template<class Iterator, class T>
+size_t find(Iterator first, size_t n, const T& value, std::false_type){
+    return std::find(first, first + n, value) - first;
+}
+
+template<class Iterator, class T>
+size_t count(Iterator first, size_t n, const T& value, std::true_type){
+    return count(&*first, n, value);
+}
+
+template<class Iterator, class T>
+size_t count(Iterator first, size_t n, const T& value, std::false_type){
+    return std::count(first, first + n, value);
+}
+} //simd
+
+/**
+ * @brief Whether Alloc can resize a block it handed out while keeping its bytes, like realloc does, through
+ * *pointer reallocate(pointer p, size_type old_n, size_type new_n)*. devector then grows & shrinks
+ * trivially relocatable elements in place instead of allocating a new block and copying them over.
+ */
+template<class Alloc>
+struct allocator_reallocation{
+private:
+    template<class A>
+    static auto test(int) -> decltype(
+        std::declval<A&>().reallocate(std::declval<typename al_traits<A>::pointer>(), size_t(), size_t()), std::true_type()
+    );
+
+    template<class A>
+    static std::false_type test(long);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
+/**
+ * @brief What an allocator's *allocate_at_least(n)* returns, a block of *count* >= n slots at *ptr*.
+ */
+template<class Pointer, class SizeType = size_t>
+struct allocation_result{
+    Pointer ptr;
+    SizeType count;
+};
+
+/**
+ * @brief Whether Alloc may hand out more slots than requested through *allocation_result allocate_at_least(size_type n)*,
+ * like C++23's allocators do. devector then uses the whole block as its capacity.
+ */
+template<class Alloc>
+struct allocator_allocation_at_least{
+private:
+    template<class A>
+    static auto test(int) -> decltype(
+        std::declval<A&>().allocate_at_least(size_t()).ptr, std::declval<A&>().allocate_at_least(size_t()).count, std::true_type()
+    );
+
+    template<class A>
+    static std::false_type test(long);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
+/**
+ * @brief Whether Alloc can grow a block it handed out at either end without moving it, through
+ * *pointer extend(pointer p, size_type n, size_type front, size_type back)*, returning the block's new start
+ * *front* slots before *p*, or a null pointer if it can't. devector then grows towards whichever end needs room
+ * without moving its elements, whenever recentering them inside the block wouldn't do.
+ */
+template<class Alloc>
+struct allocator_extension{
+private:
+    template<class A>
+    static auto test(int) -> decltype(
+        static_cast<typename al_traits<A>::pointer>(
+            std::declval<A&>().extend(std::declval<typename al_traits<A>::pointer>(), size_t(), size_t(), size_t())
+        ), std::true_type()
+    );
+
+    template<class A>
+    static std::false_type test(long);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
+/**
+ * @brief Whether Alloc can give back the memory under part of a block it handed out while keeping the block,
+ * through *void discard(pointer first, pointer last)*. devector calls it on the slots it leaves behind when recentering.
+ */
+template<class Alloc>
+struct allocator_discard{
+private:
+    template<class A>
+    static auto test(int) -> decltype(
+        std::declval<A&>().discard(std::declval<typename al_traits<A>::pointer>(), std::declval<typename al_traits<A>::pointer>()), std::true_type()
+    );
+
+    template<class A>
+    static std::false_type test(long);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
+/**
+ * @brief Whether Alloc serves some blocks from storage of its own through *bool is_inline(pointer p) const*,
+ * holding up to *size_type inline_capacity() const* elements, like small_buffer_allocator does.
+ * shrink_to_fit then keeps such blocks, since giving them back frees nothing.
+ */
+template<class Alloc>
+struct allocator_inline_storage{
+private:
+    template<class A>
+    static auto test(int) -> decltype(
+        bool(std::declval<const A&>().is_inline(std::declval<typename al_traits<A>::pointer>())),
+        typename al_traits<A>::size_type(std::declval<const A&>().inline_capacity()), std::true_type()
+    );
+
+    template<class A>
+    static std::false_type test(long);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
+/**
+ * @brief Tag for the devector constructor that takes over a buffer which already holds elements.
+ */
+struct adopt_buffer_t{
+    explicit adopt_buffer_t() = default;
+};
+
+constexpr adopt_buffer_t adopt_buffer{};
+
+struct offset_by{
+    static size_t off_by(size_t free_blocks) noexcept{
+        return free_blocks / 2;
     }
 
-    reverse_iterator rend() noexcept{
-        return reverse_iterator(begin_);
+    static constexpr float recenter_ratio() noexcept{
+        return 0.5f;
     }
 
-    const_reverse_iterator rend() const noexcept{
-        return const_reverse_iterator(begin_);
+    static constexpr bool shift_shorter_side() noexcept{
+        return true;
     }
+};
 
-    const_iterator cbegin() const noexcept{
-        return begin();
+/**
+ * @brief The operation an OffsetBy policy is asked to place *begin* for.
+ */
+enum class offset_operation{
+    construct,
+    assign,
+    push_front,
+    push_back,
+    insert,
+    erase,
+    reserve,
+    shrink_to_fit,
+    resize_front,
+    resize_back
+};
+
+/**
+ * @brief Everything known about the layout the container is about to take.
+ * 
+ * *free_blocks* and *size* describe the layout after the operation completes, 
+ * e.g. including the element being pushed, while the *old_* members describe it beforehand.
+ * *new_capacity* equals *old_capacity* unless the operation reallocates.
+ */
+struct offset_context{
+    offset_operation operation;
+    size_t free_blocks;
+    size_t size;
+    size_t old_capacity;
+    size_t new_capacity;
+    size_t old_free_front;
+    size_t old_free_back;
+};
+
+/**
+ * @brief Uniform access to the optional parts of an OffsetBy policy, falling back to
+ * rdsl::offset_by's behavior for whatever the policy doesn't provide.
+ */
+template<class OffsetBy>
+struct offset_by_traits{
+private:
+    template<class O>
+    static auto off_by(O& offs, const offset_context& context, int) -> decltype(static_cast<size_t>(offs.off_by(context))){
+        return offs.off_by(context);
     }
 
-    const_iterator cend() const noexcept{
-        return end();
+    template<class O>
+    static size_t off_by(O& offs, const offset_context& context, long){
+        return offs.off_by(context.free_blocks);
     }
 
-    const_reverse_iterator crbegin() const noexcept{
-        return rbegin();
+    template<class O>
+    static auto recenter_ratio(const O& offs, int) -> decltype(static_cast<float>(offs.recenter_ratio())){
+        return offs.recenter_ratio();
     }
 
-    const_reverse_iterator crend() const noexcept{
-        return rend();
+    template<class O>
+    static float recenter_ratio(const O&, long){
+        return offset_by::recenter_ratio();
     }
 
-    size_type size() const noexcept{
-        return end() - begin();
+    template<class O>
+    static auto shift_shorter_side(const O& offs, int) -> decltype(static_cast<bool>(offs.shift_shorter_side())){
+        return offs.shift_shorter_side();
     }
 
-    bool empty() const noexcept{
-        return end() == begin();
+    template<class O>
+    static bool shift_shorter_side(const O&, long){
+        return offset_by::shift_shorter_side();
+    }
+
+    template<class O>
+    static auto on_push_front(O& offs, size_t n, int) noexcept -> decltype(offs.on_push_front(n)){
+        return offs.on_push_front(n);
+    }
+
+    template<class O>
+    static void on_push_front(O&, size_t, long) noexcept {}
+
+    template<class O>
+    static auto on_push_back(O& offs, size_t n, int) noexcept -> decltype(offs.on_push_back(n)){
+        return offs.on_push_back(n);
+    }
+
+    template<class O>
+    static void on_push_back(O&, size_t, long) noexcept {}
+
+    template<class O>
+    static auto on_pop_front(O& offs, size_t n, int) noexcept -> decltype(offs.on_pop_front(n)){
+        return offs.on_pop_front(n);
+    }
+
+    template<class O>
+    static void on_pop_front(O&, size_t, long) noexcept {}
+
+    template<class O>
+    static auto on_pop_back(O& offs, size_t n, int) noexcept -> decltype(offs.on_pop_back(n)){
+        return offs.on_pop_back(n);
+    }
+
+    template<class O>
+    static void on_pop_back(O&, size_t, long) noexcept {}
+
+public:
+    /**
+     * @brief *begin*'s offset from the start of the array for the layout described by *context*.
+     * Calls *off_by(const offset_context&)* if the policy has it, *off_by(size_t free_blocks)* otherwise.
+     * The result is clamped to *context.free_blocks*.
+     */
+    static size_t off_by(OffsetBy& offs, const offset_context& context){
+        const size_t offset = off_by(offs, context, 0);
+        return offset < context.free_blocks ? offset : context.free_blocks;
+    }
+
+    /**
+     * @brief The fraction of capacity that must be free for a full end to be
+     * made room for by sliding the elements inside the current allocation, instead of growing it.
+     * A value of 1 or more disables recentering.
+     */
+    static float recenter_ratio(const OffsetBy& offs){
+        return recenter_ratio(offs, 0);
+    }
+
+    /**
+     * @brief Whether inserting or erasing in the middle only shifts the elements on one side of the gap, the shorter one,
+     * into the free space next to it or over the erased elements. When false, or when neither side has room
+     * to insert, the whole container is moved to wherever off_by places *begin*.
+     */
+    static bool shift_shorter_side(const OffsetBy& offs){
+        return shift_shorter_side(offs, 0);
+    }
+
+    /**
+     * @brief Notifications about elements being added or removed at either end,
+     * for policies that place *begin* according to how the container is used. No-ops by default.
+     */
+    static void on_push_front(OffsetBy& offs, size_t n) noexcept{
+        on_push_front(offs, n, 0);
+    }
+
+    static void on_push_back(OffsetBy& offs, size_t n) noexcept{
+        on_push_back(offs, n, 0);
+    }
+
+    static void on_pop_front(OffsetBy& offs, size_t n) noexcept{
+        on_pop_front(offs, n, 0);
+    }
+
+    static void on_pop_back(OffsetBy& offs, size_t n) noexcept{
+        on_pop_back(offs, n, 0);
+    }
+};
+
+/**
+ * @brief Splits free space between the two ends in proportion to the demand observed for each of them.
+ * 
+ * Pushes at an end count as demand for it, pops at the same end give back to it. Every call to off_by
+ * halves the counters, so recent usage weighs more than old one and the policy follows phase changes.
+ */
+struct adaptive_offset_by{
+    size_t off_by(size_t free_blocks) noexcept{
+        // +1 on both sides so no end is starved of space until it has been observed.
+        const double front_weight = front_demand + 1.0;
+        const double back_weight = back_demand + 1.0;
+        const size_t offset = static_cast<size_t>(free_blocks * (front_weight / (front_weight + back_weight)));
+
+        front_demand /= 2;
+        back_demand /= 2;
+
+        return offset < free_blocks ? offset : free_blocks;
+    }
+
+    static constexpr float recenter_ratio() noexcept{
+        return offset_by::recenter_ratio();
+    }
+
+    static constexpr bool shift_shorter_side() noexcept{
+        return offset_by::shift_shorter_side();
+    }
+
+    void on_push_front(size_t n) noexcept{
+        front_demand += n;
+    }
+
+    void on_push_back(size_t n) noexcept{
+        back_demand += n;
+    }
+
+    void on_pop_front(size_t n) noexcept{
+        front_demand -= n < front_demand ? n : front_demand;
+    }
+
+    void on_pop_back(size_t n) noexcept{
+        back_demand -= n < back_demand ? n : back_demand;
+    }
+
+    size_t front_demand = 0;
+    size_t back_demand = 0;
+};
+
+/**
+ * @brief Grows capacity by Numerator / Denominator, plus one so an empty container gets a slot.
+ * The default of 8 / 5 matches the 1.6 factor devector always used.
+ */
+template<size_t Numerator = 8, size_t Denominator = 5>
+struct geometric_growth{
+    static_assert(Numerator > Denominator && Denominator > 0, "geometric_growth needs a factor greater than 1");
+
+    static size_t next_capacity(size_t capacity, size_t max_size) noexcept{
+        if(capacity / Denominator >= max_size / Numerator){
+            return max_size;
+        }
+
+        // capacity * Numerator / Denominator, without overflowing.
+        const size_t grown = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+        return grown < max_size ? grown + 1 : max_size;
+    }
+
+    static size_t capacity_to_fit(size_t capacity, size_t n, size_t max_size) noexcept{
+        const size_t next = next_capacity(capacity, max_size);
+        return n > next ? n : next;
+    }
+};
+
+/**
+ * @brief Keeps capacity a power of two.
+ */
+struct power_of_two_growth{
+    static size_t next_capacity(size_t capacity, size_t max_size) noexcept{
+        return capacity < max_size ? capacity_to_fit(capacity, capacity + 1, max_size) : max_size;
+    }
+
+    static size_t capacity_to_fit(size_t, size_t n, size_t max_size) noexcept{
+        if(n <= 1){
+            return 1;
+        }
+
+        size_t ceil = n - 1;
+        for(size_t shift = 1; shift < sizeof(size_t) * CHAR_BIT; shift <<= 1){
+            ceil |= ceil >> shift;
+        }
+
+        return ceil < max_size ? ceil + 1 : max_size;
+    }
+};
+
+/**
+ * @brief Grows capacity by a fixed amount of Chunk elements at a time.
+ */
+template<size_t Chunk>
+struct chunked_growth{
+    static_assert(Chunk > 0, "chunked_growth needs a non zero chunk");
+
+    static size_t next_capacity(size_t capacity, size_t max_size) noexcept{
+        return max_size - capacity > Chunk ? capacity + Chunk : max_size;
+    }
+
+    static size_t capacity_to_fit(size_t, size_t n, size_t max_size) noexcept{
+        const size_t remainder = n % Chunk;
+        if(!remainder){
+            return n ? n : Chunk;
+        }
+        return max_size - n > Chunk - remainder ? n + (Chunk - remainder) : max_size;
+    }
+};
+
+/**
+ * @brief Wraps *Growth* to also give memory back: once fewer than Numerator / Denominator of the slots are in use,
+ * capacity drops to twice the size, never below MinCapacity. Shrinking stops well short of full, so it takes
+ * the size doubling to grow again & halving once more to shrink again, and the container never oscillates.
+ */
+template<class Growth = rdsl::geometric_growth<>, size_t Numerator = 1, size_t Denominator = 4, size_t MinCapacity = 16>
+struct hysteresis_shrink: public Growth{
+    static_assert(Denominator > 2 * Numerator && Numerator > 0, "hysteresis_shrink needs a fraction below 1 / 2");
+
+    size_t shrink_capacity(size_t capacity, size_t size) const noexcept{
+        if(capacity <= MinCapacity || size >= capacity / Denominator * Numerator){
+            return capacity;
+        }
+
+        const size_t target = 2 * size;
+        return target > MinCapacity ? target : MinCapacity;
+    }
+};
+
+/**
+ * @brief Uniform access to the optional parts of a GrowthPolicy.
+ */
+template<class GrowthPolicy>
+struct growth_policy_traits{
+private:
+    template<class G>
+    static auto test(int) -> decltype(static_cast<size_t>(std::declval<const G&>().shrink_capacity(size_t(), size_t())), std::true_type());
+
+    template<class G>
+    static std::false_type test(long);
+
+public:
+    /**
+     * @brief Whether the policy has *size_t shrink_capacity(size_t capacity, size_t size)*, which devector calls
+     * after removing elements & reallocates to whatever smaller capacity it returns.
+     */
+    static constexpr bool shrinks = decltype(test<GrowthPolicy>(0))::value;
+};
+
+/**
+ * @brief The default statistics policy, keeps nothing. Every hook is an empty inline call the compiler drops.
+ */
+struct no_stats{
+    void on_allocate(size_t /* capacity */, size_t /* bytes */) noexcept {}
+    void on_reallocate() noexcept {}
+    void on_shift() noexcept {}
+    void on_construct(size_t /* n */) noexcept {}
+    void on_move(size_t /* n */, size_t /* bytes */) noexcept {}
+    void on_destroy(size_t /* n */) noexcept {}
+    void on_shrink(size_t /* capacity */, size_t /* bytes */) noexcept {}
+};
+
+/**
+ * @brief Counts what a devector does with its memory & elements, to tune OffsetBy & GrowthPolicy from real traffic.
+ *
+ * *constructed* & *destroyed* count elements entering & leaving the container, so their difference is its size.
+ * Elements changing slot, whether by reallocation or by shifting inside the same buffer, count as *moved* instead.
+ */
+struct devector_stats{
+    size_t reallocations = 0;   // times the elements were moved to a new buffer
+    size_t shifts = 0;          // times they were shifted inside the same buffer, by insert, erase or recentering
+    size_t constructed = 0;
+    size_t moved = 0;
+    size_t moved_bytes = 0;
+    size_t destroyed = 0;
+    size_t bytes_allocated = 0;
+    size_t peak_capacity = 0;
+    size_t bytes_released = 0;  // given back by shrinking, explicitly or through the growth policy
+
+    void reset() noexcept{
+        *this = devector_stats();
+    }
+
+    void on_allocate(size_t capacity, size_t bytes) noexcept{
+        bytes_allocated += bytes;
+        peak_capacity = capacity > peak_capacity ? capacity : peak_capacity;
+    }
+
+    void on_reallocate() noexcept{
+        ++reallocations;
+    }
+
+    void on_shift() noexcept{
+        ++shifts;
+    }
+
+    void on_construct(size_t n) noexcept{
+        constructed += n;
+    }
+
+    void on_move(size_t n, size_t bytes) noexcept{
+        moved += n;
+        moved_bytes += bytes;
+    }
+
+    void on_destroy(size_t n) noexcept{
+        destroyed += n;
+    }
+
+    void on_shrink(size_t, size_t bytes) noexcept{
+        bytes_released += bytes;
+    }
+};
+
+/**
+ * @brief Uniform access to the optional hooks of a Stats policy, no-ops for those it doesn't provide.
+ */
+template<class Stats>
+struct stats_traits{
+private:
+    template<class S>
+    static auto on_shrink(S& stats, size_t capacity, size_t bytes, int) noexcept -> decltype(stats.on_shrink(capacity, bytes)){
+        return stats.on_shrink(capacity, bytes);
+    }
+
+    template<class S>
+    static void on_shrink(S&, size_t, size_t, long) noexcept {}
+
+public:
+    /**
+     * @brief Called whenever the container moves to a smaller allocation of *capacity* slots, giving back *bytes*.
+     */
+    static void on_shrink(Stats& stats, size_t capacity, size_t bytes) noexcept{
+        on_shrink(stats, capacity, bytes, 0);
+    }
+};
+
+template<
+    typename T,
+    class Alloc = std::allocator<T>,
+    class OffsetBy = rdsl::offset_by,
+    class GrowthPolicy = rdsl::geometric_growth<>,
+    class Stats = rdsl::no_stats
+>
+struct devector{
+    using value_type = T;
+    using allocator_type = Alloc;
+    using offset_by_type = OffsetBy;
+    using growth_policy_type = GrowthPolicy;
+    using stats_type = Stats;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename al_traits<allocator_type>::pointer;
+    using const_pointer = typename al_traits<allocator_type>::const_pointer;
+    using size_type = typename al_traits<allocator_type>::size_type;
+    using difference_type = typename al_traits<allocator_type>::difference_type;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief *capacity* slots at *arr*, allocated by the container's allocator, of which [begin, end) hold live elements.
+     */
+    struct raw_buffer{
+        pointer arr;
+        size_type capacity;
+        pointer begin;
+        pointer end;
+    };
+
+private:
+    struct compressed_alloc: public allocator_type{
+        compressed_alloc(const allocator_type& alloc = allocator_type())
+        :allocator_type(alloc)
+        {}
+
+        compressed_alloc(const compressed_alloc&) = delete;
+        compressed_alloc(compressed_alloc&&) noexcept = delete;
+        compressed_alloc& operator=(const compressed_alloc&) = delete;
+        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+
+        allocator_type& get() noexcept{ return *this; }
+        const allocator_type& get() const noexcept{ return *this; }
+
+        pointer arr;
+    }alloc;
+
+    // The growth & statistics policies share the offset policy's slot, all of them are usually empty.
+    struct compressed_offs: public offset_by_type, public growth_policy_type, public stats_type{
+        compressed_offs(const offset_by_type& offs = offset_by_type())
+        :offset_by_type(offs)
+        {}
+
+        compressed_offs(const compressed_offs&) = delete;
+        compressed_offs(compressed_offs&&) noexcept = delete;
+        compressed_offs& operator=(const compressed_offs&) = delete;
+        compressed_offs& operator=(compressed_offs&&) noexcept = delete;
+
+        offset_by_type& get() noexcept{ return *this; }
+        const offset_by_type& get() const noexcept{ return *this; }
+
+        growth_policy_type& growth() noexcept{ return *this; }
+        const growth_policy_type& growth() const noexcept{ return *this; }
+
+        stats_type& stats() noexcept{ return *this; }
+        const stats_type& stats() const noexcept{ return *this; }
+
+        size_type capacity;
+    }offs;
+
+    pointer begin_;
+    pointer end_;
+
+    using relocation_tag = std::integral_constant<bool,
+        is_trivially_relocatable<value_type>::value && std::is_same<pointer, value_type*>::value
+    >;
+
+    // Trivially copyable elements are copied & filled in bulk, with memcpy, memset or loops the compiler vectorizes.
+    using bulk_tag = std::integral_constant<bool,
+        std::is_trivially_copyable<value_type>::value && std::is_same<pointer, value_type*>::value
+    >;
+
+    using in_place_tag = std::integral_constant<bool,
+        relocation_tag::value && allocator_reallocation<allocator_type>::value
+    >;
+
+    // Recentering shifts elements in place, it's only attempted when that can't throw halfway through.
+    using recenter_tag = std::integral_constant<bool,
+        relocation_tag::value || std::is_nothrow_move_constructible<value_type>::value
+    >;
+
+    struct buffer_guard{
+        pointer begin;
+        pointer end;
+        allocator_type& alloc;
+
+        buffer_guard(allocator_type& alloc, pointer begin, pointer end)
+        :alloc(alloc), begin(begin), end(end) {}
+
+        buffer_guard(allocator_type& alloc, pointer start)
+        :alloc(alloc), begin(start), end(start) {}
+
+        buffer_guard(allocator_type& alloc)
+        :alloc(alloc), begin(nullptr), end(nullptr) {}
+
+        void guard(pointer begin, pointer end){
+            this->begin = begin;
+            this->end = end;
+        }
+
+        void guard(pointer start){
+            begin = end = start;
+        }
+
+        void release(){
+            begin = end;
+        }
+
+        ~buffer_guard(){
+            while(begin != end){
+                al_traits<allocator_type>::destroy(alloc, begin);
+                ++begin;
+            }
+        }
+    };
+
+    struct memory_guard{
+        pointer arr;
+        size_type capacity;
+        allocator_type& alloc;
+
+        // *capacity* is raised to whatever the allocator handed out before the member is initialized from it.
+        memory_guard(allocator_type& alloc, size_type capacity)
+        :arr(allocate_at_least(alloc, capacity)), capacity(capacity), alloc(alloc) {}
+
+        void release(){
+            arr = nullptr;
+        }
+
+        ~memory_guard(){
+            if(arr){
+                alloc.deallocate(arr, capacity);
+            }
+        }
+    };
+
+public:
+
+    size_type capacity() const noexcept{
+        return offs.capacity;
+    }
+
+    size_type max_size() const{
+        return al_traits<allocator_type>::max_size(alloc);
+    }
+
+    iterator begin() noexcept{
+        return begin_;
+    }
+
+    const_iterator begin() const noexcept{
+        return begin_;
+    }
+
+    iterator end() noexcept{
+        return end_;
+    }
+
+    const_iterator end() const noexcept{
+        return end_;
+    }
+
+    reverse_iterator rbegin() noexcept{
+        return reverse_iterator(end_);
+    }
+
+    const_reverse_iterator rbegin() const noexcept{
+        return const_reverse_iterator(end_);
+    }
+
+    reverse_iterator rend() noexcept{
+        return reverse_iterator(begin_);
+    }
+
+    const_reverse_iterator rend() const noexcept{
+        return const_reverse_iterator(begin_);
+    }
+
+    const_iterator cbegin() const noexcept{
+        return begin();
+    }
+
+    const_iterator cend() const noexcept{
+        return end();
+    }
+
+    const_reverse_iterator crbegin() const noexcept{
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const noexcept{
+        return rend();
+    }
+
+    size_type size() const noexcept{
+        return end() - begin();
+    }
+
+    bool empty() const noexcept{
+        return end() == begin();
     }
 
 private:
@@ -270,97 +1227,527 @@ private:
     size_type free_back() const noexcept{ return alloc.arr + offs.capacity - end_; }
     size_type free_total() const noexcept{ return offs.capacity - size(); }
 
-    pointer allocate_n(size_type n){
-        auto ptr = alloc.allocate(n);
-        offs.capacity = n;
-        return ptr;
+    /**
+     * @brief Allocates at least *n* slots, setting *n* to how many the allocator actually handed out.
+     */
+    static pointer allocate_at_least(allocator_type& allocator, size_type& n){
+        return allocate_at_least(allocator, n, std::integral_constant<bool, allocator_allocation_at_least<allocator_type>::value>());
+    }
+
+    static pointer allocate_at_least(allocator_type& allocator, size_type& n, std::true_type){
+        const auto result = allocator.allocate_at_least(n);
+        n = result.count;
+        return result.ptr;
+    }
+
+    static pointer allocate_at_least(allocator_type& allocator, size_type& n, std::false_type){
+        return allocator.allocate(n);
+    }
+
+    bool is_inline() const noexcept{
+        return is_inline(std::integral_constant<bool, allocator_inline_storage<allocator_type>::value>());
+    }
+
+    bool is_inline(std::true_type) const noexcept{
+        return offs.capacity && alloc.get().is_inline(alloc.arr);
+    }
+
+    bool is_inline(std::false_type) const noexcept{
+        return false;
+    }
+
+    pointer allocate_n(size_type n){
+        // Nothing is allocated for no elements, a capacity of 0 is never deallocated.
+        if(!n){
+            offs.capacity = 0;
+            return pointer();
+        }
+
+        auto ptr = allocate_at_least(alloc, n);
+        offs.capacity = n;
+        offs.stats().on_allocate(n, n * sizeof(value_type));
+        return ptr;
+    }
+
+    void deallocate() noexcept{
+        if(offs.capacity){
+            alloc.deallocate(alloc.arr, offs.capacity);
+            offs.capacity = 0;
+        }
+    }
+
+    /**
+     * @brief Whether elements can be copied from *Source* with a single memcpy, the source being a plain pointer to them.
+     */
+    template<class Source>
+    using bulk_copy_tag = std::integral_constant<bool,
+        bulk_tag::value && std::is_pointer<Source>::value &&
+        std::is_same<typename std::remove_cv<typename std::remove_pointer<Source>::type>::type, value_type>::value
+    >;
+
+    /**
+     * @brief Fills *n* unconstructed slots at *p* with copies of *val*. Single bytes & all zero values are memset,
+     * anything else is left to a loop simple enough for the compiler to vectorize.
+     */
+    static void fill(pointer p, size_type n, const value_type& val) noexcept{
+        if(!n){
+            return;
+        }
+
+        unsigned char bytes[sizeof(value_type)];
+        std::memcpy(bytes, std::addressof(val), sizeof(value_type));
+
+        bool zero = true;
+        for(unsigned char byte: bytes){
+            zero = zero && !byte;
+        }
+
+        if(sizeof(value_type) == 1 || zero){
+            std::memset(static_cast<void*>(p), bytes[0], n * sizeof(value_type));
+        }else{
+            std::uninitialized_fill_n(p, n, val);
+        }
+    }
+
+    void construct(size_type n, const_reference val, offset_operation operation){
+        begin_ = end_ = alloc.arr + offset_for(operation, n);
+        construct_n(n, val, bulk_tag());
+    }
+
+    void construct_n(size_type n, const_reference val, std::true_type) noexcept{
+        fill(end_, n, val);
+        end_ += n;
+        offs.stats().on_construct(n);
+    }
+
+    void construct_n(size_type n, const_reference val, std::false_type){
+        while(n--){
+            al_traits<allocator_type>::construct(alloc, end_, val);
+            ++end_;
+            offs.stats().on_construct(1);
+        }
+    }
+
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    void construct(InputIterator first, size_type distance, offset_operation operation){
+        begin_ = end_ = alloc.arr + offset_for(operation, distance);
+        construct_n(first, distance, bulk_copy_tag<InputIterator>());
+    }
+
+    template<class InputIterator>
+    void construct_n(InputIterator first, size_type distance, std::true_type) noexcept{
+        if(distance){
+            std::memcpy(static_cast<void*>(end_), static_cast<const void*>(first), distance * sizeof(value_type));
+        }
+        end_ += distance;
+        offs.stats().on_construct(distance);
+    }
+
+    template<class InputIterator>
+    void construct_n(InputIterator first, size_type distance, std::false_type){
+        while(distance--){
+            al_traits<allocator_type>::construct(alloc, end_, *first);
+            ++first;
+            ++end_;
+            offs.stats().on_construct(1);
+        }
+    }
+
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    void construct_move(InputIterator first, size_type distance, offset_operation operation){
+        if(bulk_copy_tag<InputIterator>::value){
+            // Moving trivially copyable elements copies them.
+            construct(first, distance, operation);
+            return;
+        }
+
+        begin_ = end_ = alloc.arr + offset_for(operation, distance);
+        while(distance--){
+            al_traits<allocator_type>::construct(alloc, end_, std::move_if_noexcept(*first));
+            ++first;
+            ++end_;
+            offs.stats().on_construct(1);
+        }
+    }
+
+    /**
+     * @brief Replaces the elements with *count* ones from *first*, laid out as OffsetBy wants for assign.
+     * Elements already inside their new slots are assigned to, the rest constructed. Capacity must fit *count*.
+     */
+    template<class InputIterator>
+    void assign_over(InputIterator first, size_type count){
+        const pointer new_begin = alloc.arr + offset_for(offset_operation::assign, count);
+        const pointer new_end = new_begin + count;
+
+        const size_type old_size = size();
+        while(!empty() && begin_ < new_begin){
+            destroy_front();
+        }
+        
+        while(!empty() && end_ > new_end){
+            destroy_back();
+        }
+        offs.stats().on_destroy(old_size - size());
+
+        assign_over(first, new_begin, new_end, bulk_copy_tag<InputIterator>());
+    }
+
+    template<class InputIterator>
+    void assign_over(InputIterator first, pointer new_begin, pointer new_end, std::true_type) noexcept{
+        if(new_end != new_begin){
+            std::memcpy(static_cast<void*>(new_begin), static_cast<const void*>(first), (new_end - new_begin) * sizeof(value_type));
+        }
+        offs.stats().on_construct((new_end - new_begin) - size());
+
+        begin_ = new_begin;
+        end_ = new_end;
+    }
+
+    template<class InputIterator>
+    void assign_over(InputIterator first, pointer new_begin, pointer new_end, std::false_type){
+        buffer_guard guard(alloc, new_begin);
+
+        for(; guard.end != new_end; ++first, ++guard.end){
+            if(in_bounds(guard.end)){
+                *guard.end = *first;
+            }else{
+                al_traits<allocator_type>::construct(alloc, guard.end, *first);
+                offs.stats().on_construct(1);
+            }
+        }
+
+        begin_ = new_begin;
+        end_ = new_end;
+        guard.release();
+    }
+
+    /**
+     * @brief Asks OffsetBy where *begin* should lie once the container holds *new_size* elements in *new_capacity* slots.
+     */
+    size_type offset_for(offset_operation operation, size_type new_size, size_type new_capacity){
+        const offset_context context{
+            operation, new_capacity - new_size, new_size, offs.capacity, new_capacity, free_front(), free_back()
+        };
+        return offset_by_traits<offset_by_type>::off_by(offs, context);
+    }
+
+    size_type offset_for(offset_operation operation, size_type new_size){
+        return offset_for(operation, new_size, offs.capacity);
+    }
+
+    void destroy_back() noexcept{
+        al_traits<allocator_type>::destroy(alloc, end_ - 1);
+        --end_;
+    }
+
+    void destroy_front() noexcept{
+        al_traits<allocator_type>::destroy(alloc, begin_);
+        ++begin_;
+    }
+
+    void pop_front_n(size_type n) noexcept{
+        offset_by_traits<offset_by_type>::on_pop_front(offs, n);
+        offs.stats().on_destroy(n);
+        const pointer first = begin_;
+        begin_ += n;
+        for(pointer p = first; p != begin_; ++p){
+            al_traits<allocator_type>::destroy(alloc, p);
+        }
+    }
+
+    void pop_back_n(size_type n) noexcept{
+        offset_by_traits<offset_by_type>::on_pop_back(offs, n);
+        offs.stats().on_destroy(n);
+        const pointer last = end_;
+        end_ -= n;
+        for(pointer p = end_; p != last; ++p){
+            al_traits<allocator_type>::destroy(alloc, p);
+        }
+    }
+
+    /**
+     * @brief Default-initializes an element at *p*, which leaves trivial types uninitialized.
+     */
+    void construct_for_overwrite(pointer p){
+        construct_for_overwrite(p, std::integral_constant<bool,
+            std::is_trivially_default_constructible<value_type>::value && std::is_same<pointer, value_type*>::value
+        >());
+    }
+
+    void construct_for_overwrite(pointer p, std::true_type) noexcept{
+        ::new(static_cast<void*>(p)) value_type;
+    }
+
+    void construct_for_overwrite(pointer p, std::false_type){
+        al_traits<allocator_type>::construct(alloc, p);
+    }
+
+    void destroy_all() noexcept{
+        offs.stats().on_destroy(size());
+        destroy_moved();
+    }
+
+    /**
+     * @brief Destroys what's left of elements that were moved elsewhere, which doesn't count as removing them.
+     */
+    void destroy_moved() noexcept{
+        for(pointer p = begin_; p != end_; ++p){
+            al_traits<allocator_type>::destroy(alloc, p);
+        }
+        begin_ = end_;
+    }
+
+    void count_moves(size_type n) noexcept{
+        offs.stats().on_move(n, n * sizeof(value_type));
+    }
+
+    void steal_ownership(devector& x) noexcept{
+        offs.stats().on_construct(x.size());
+        x.offs.stats().on_destroy(x.size());
+
+        offs.capacity = x.offs.capacity;
+        alloc.arr = x.alloc.arr;
+        begin_ = x.begin_;
+        end_ = x.end_;
+        
+        x.alloc.arr = x.begin_ = x.end_ = nullptr;
+        x.offs.capacity = 0;
+    }
+
+    // Allocators are only assigned or swapped when their propagate_on_container_* trait says so,
+    // some of them, like std::pmr::polymorphic_allocator, can't be assigned at all.
+    template<class Allocator>
+    void propagate_allocator(Allocator&& allocator, std::true_type){
+        alloc.get() = std::forward<Allocator>(allocator);
+    }
+
+    template<class Allocator>
+    void propagate_allocator(Allocator&&, std::false_type) noexcept{}
+
+    void swap_allocator(devector& x, std::true_type){
+        using std::swap;
+        swap(alloc.get(), x.alloc.get());
+    }
+
+    void swap_allocator(devector&, std::false_type) noexcept{}
+
+    bool in_bounds(pointer it) const noexcept{
+        return it >= begin_ && it < end_;
+    }
+
+    size_type next_capacity() const{
+        const size_type new_capacity = offs.growth().next_capacity(offs.capacity, max_size());
+        if(new_capacity <= offs.capacity){
+            throw std::length_error("devector cannot grow past max_size()");
+        }
+        return new_capacity;
+    }
+    /**
+     * @brief Moves [first, last) to *dest* by copying bytes. Ranges may overlap.
+     * Only valid for trivially relocatable types, the source is left without live objects.
+     */
+    void relocate(pointer first, pointer last, pointer dest) noexcept{
+        if(first != last){
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(value_type));
+        }
+    }
+
+    /**
+     * @brief Allocates a new memory chunk of at least *new_capacity* capacity and moves all elements into it,
+     * placing them where OffsetBy wants *begin* for *operation* on *new_size* elements, plus *front_gap* slots.
+     * *new capacity* should be greater equal to *new_size*, which should be greater equal to size + front_gap.
+     */
+    void reallocate(size_type new_capacity, offset_operation operation, size_type new_size, size_type front_gap = 0){
+        offs.stats().on_reallocate();
+        count_moves(size());
+        reallocate(new_capacity, operation, new_size, front_gap, relocation_tag());
+    }
+
+    void reallocate(size_type new_capacity, offset_operation operation, size_type new_size, size_type front_gap, std::false_type){
+        memory_guard mem_guard(alloc, new_capacity);
+
+        buffer_guard buf_guard(alloc, mem_guard.arr + offset_for(operation, new_size, mem_guard.capacity) + front_gap);
+     
+        for(auto it = begin_; it != end_; ++it, ++buf_guard.end){
+            al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*it));
+        }
+        destroy_moved();
+        deallocate();
+
+        alloc.arr = mem_guard.arr;
+        begin_ = buf_guard.begin;
+        end_ = buf_guard.end;
+        offs.capacity = mem_guard.capacity;
+        offs.stats().on_allocate(mem_guard.capacity, mem_guard.capacity * sizeof(value_type));
+
+        buf_guard.release();
+        mem_guard.release();
+    }
+
+    void reallocate(size_type new_capacity, offset_operation operation, size_type new_size, size_type front_gap, std::true_type){
+        if(in_place_tag::value && offs.capacity){
+            resize_in_place(new_capacity, offset_for(operation, new_size, new_capacity) + front_gap, in_place_tag());
+            return;
+        }
+
+        memory_guard mem_guard(alloc, new_capacity);
+
+        const pointer new_begin = mem_guard.arr + offset_for(operation, new_size, mem_guard.capacity) + front_gap;
+        const size_type count = size();
+
+        relocate(begin_, end_, new_begin);
+        deallocate();
+
+        alloc.arr = mem_guard.arr;
+        begin_ = new_begin;
+        end_ = new_begin + count;
+        offs.capacity = mem_guard.capacity;
+        offs.stats().on_allocate(mem_guard.capacity, mem_guard.capacity * sizeof(value_type));
+
+        mem_guard.release();
+    }
+
+    bool resize_in_place(size_type, size_type, std::false_type) noexcept{
+        return false;
+    }
+
+    /**
+     * @brief Resizes the allocation itself through the allocator's reallocate, sliding the elements to *offset* inside it.
+     */
+    bool resize_in_place(size_type new_capacity, size_type offset, std::true_type){
+        const size_type count = size();
+
+        if(new_capacity < offs.capacity){
+            // Slide first so nothing lies past the new end, the container stays valid if shrinking throws.
+            shift_to(alloc.arr + offset, relocation_tag());
+            alloc.arr = alloc.reallocate(alloc.arr, offs.capacity, new_capacity);
+        }else{
+            const size_type old_offset = free_front();
+            alloc.arr = alloc.reallocate(alloc.arr, offs.capacity, new_capacity);
+            relocate(alloc.arr + old_offset, alloc.arr + old_offset + count, alloc.arr + offset);
+        }
+
+        begin_ = alloc.arr + offset;
+        end_ = begin_ + count;
+        offs.capacity = new_capacity;
+        offs.stats().on_allocate(new_capacity, new_capacity * sizeof(value_type));
+
+        return true;
+    }
+
+    void reallocate(size_type new_capacity, offset_operation operation){
+        reallocate(new_capacity, operation, size());
+    }
+
+    // A full heap block still frees memory on shrinking when the elements fit back into the allocator's own storage.
+    bool is_tight() const noexcept{
+        return size() == offs.capacity && !fits_inline(std::integral_constant<bool, allocator_inline_storage<allocator_type>::value>());
     }
 
-    void deallocate() noexcept{
-        if(offs.capacity){
-            alloc.deallocate(alloc.arr, offs.capacity);
-            offs.capacity = 0;
-        }
+    bool fits_inline(std::true_type) const noexcept{
+        return offs.capacity && !alloc.get().is_inline(alloc.arr) && size() <= alloc.get().inline_capacity();
     }
 
-    void construct(size_type n, const_reference val){
-        begin_ = end_ = alloc.arr + offs.off_by(offs.capacity - n);
-        while(n--){
-            al_traits<allocator_type>::construct(alloc, end_, val);
-            ++end_;
-        }
+    bool fits_inline(std::false_type) const noexcept{
+        return false;
     }
 
-    template<class InputIterator, is_iterator<InputIterator> = 0>
-    void construct(InputIterator first, size_type distance){
-        begin_ = end_ = alloc.arr + offs.off_by(offs.capacity - distance);
-        while(distance--){
-            al_traits<allocator_type>::construct(alloc, end_, *first);
-            ++first;
-            ++end_;
+    void shrink(size_type new_capacity){
+        const size_type old_capacity = offs.capacity;
+        if(!new_capacity){
+            // Reallocating an empty container to 0 slots would still get a block from allocate(0), never given back.
+            deallocate();
+            alloc.arr = begin_ = end_ = nullptr;
+        }else{
+            reallocate(new_capacity, offset_operation::shrink_to_fit);
         }
-    }
 
-    template<class InputIterator, is_iterator<InputIterator> = 0>
-    void construct_move(InputIterator first, size_type distance){
-        begin_ = end_ = alloc.arr + offs.off_by(offs.capacity - distance);
-        while(distance--){
-            al_traits<allocator_type>::construct(alloc, end_, std::move_if_noexcept(*first));
-            ++first;
-            ++end_;
+        if(offs.capacity < old_capacity){
+            stats_traits<stats_type>::on_shrink(offs.stats(), offs.capacity, (old_capacity - offs.capacity) * sizeof(value_type));
         }
     }
 
-    void destroy_all() noexcept{
-        while(begin_ != end_){
-            al_traits<allocator_type>::destroy(alloc, begin_);
-            ++begin_;
+    /**
+     * @brief Hands the GrowthPolicy the chance to shrink the container after elements were removed.
+     * Failing to reallocate only keeps the bigger buffer, so it never throws.
+     */
+    void shrink_if_sparse() noexcept{
+        shrink_if_sparse(std::integral_constant<bool, growth_policy_traits<growth_policy_type>::shrinks>());
+    }
+
+    void shrink_if_sparse(std::false_type) noexcept {}
+
+    void shrink_if_sparse(std::true_type) noexcept{
+        const size_type new_capacity = offs.growth().shrink_capacity(offs.capacity, size());
+        if(new_capacity >= offs.capacity || is_inline()){
+            return;
+        }
+
+        try{
+            shrink(new_capacity);
+        }catch(...){
         }
     }
 
-    void steal_ownership(devector& x) noexcept{
-        offs.capacity = x.offs.capacity;
-        alloc.arr = x.alloc.arr;
-        begin_ = x.begin_;
-        end_ = x.end_;
-        
-        x.alloc.arr = x.begin_ = x.end_ = nullptr;
-        x.offs.capacity = 0;
+    /**
+     * @brief Grows the allocation by *front* slots before it & *back* after it, through the allocator's extend.
+     * No element moves. Returns false, changing nothing, if the allocator can't.
+     */
+    bool extend(size_type front, size_type back){
+        return extend(front, back, std::integral_constant<bool, allocator_extension<allocator_type>::value>());
     }
-    
-    bool in_bounds(pointer it) const noexcept{
-        return it >= begin_ && it < end_;
+
+    bool extend(size_type, size_type, std::false_type) noexcept{
+        return false;
     }
 
-    int next_capacity() const noexcept{
-        return factor * offs.capacity + 1;
+    bool extend(size_type front, size_type back, std::true_type){
+        if(!offs.capacity){
+            return false;
+        }
+
+        const pointer arr = alloc.get().extend(alloc.arr, offs.capacity, front, back);
+        if(!arr){
+            return false;
+        }
+
+        alloc.arr = arr;
+        offs.capacity += front + back;
+        offs.stats().on_allocate(offs.capacity, (front + back) * sizeof(value_type));
+        return true;
     }
+
     /**
-     * @brief Allocates a new memory chunk of *new_capacity* capacity and copies all elements into it, respecting the offset factor.
-     * *new capacity* should be greater equal to size.
+     * @brief Lets the allocator take back the memory under the free slots [first, last), if it can.
      */
-    void reallocate(size_type new_capacity, size_type offset){
-        memory_guard mem_guard(alloc, new_capacity);
+    void discard(pointer first, pointer last) noexcept{
+        discard(first, last, std::integral_constant<bool, allocator_discard<allocator_type>::value>());
+    }
 
-        buffer_guard buf_guard(alloc, mem_guard.arr + offset);
-     
-        for(; begin_ != end_; ++begin_, ++buf_guard.end){
-            al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*begin_));
+    void discard(pointer, pointer, std::false_type) noexcept {}
+
+    void discard(pointer first, pointer last, std::true_type) noexcept{
+        if(first != last){
+            alloc.get().discard(first, last);
         }
-        destroy_all();
-        deallocate();
+    }
 
-        alloc.arr = mem_guard.arr;
-        begin_ = buf_guard.begin;
-        end_ = buf_guard.end;
-        offs.capacity = new_capacity;
+    /**
+     * @brief Extends the allocation by at least what the growth policy asks for, so that *n* more elements
+     * go before the *index*-th one without moving those at either end. Inserting at the front of a non empty
+     * container grows the front, anywhere else the back. *n* must exceed the room already there.
+     */
+    bool extend_for(size_type index, size_type n){
+        if(!allocator_extension<allocator_type>::value || !offs.capacity){
+            return false;
+        }
 
-        buf_guard.release();
-        mem_guard.release();
-    }
+        const bool front = !index && !empty();
+        const size_type grown = capacity_to_fit(size() + n) - offs.capacity;
+        const size_type missing = n - (front ? free_front() : free_back());
+        const size_type extra = grown > missing ? grown : missing;
 
-    void reallocate(size_type new_capacity){
-        reallocate(new_capacity, offs.off_by(new_capacity - size()));
+        return front ? extend(extra, 0) : extend(0, extra);
     }
 
     template<class Pred>
@@ -383,6 +1770,68 @@ private:
         }
     }
 
+    /**
+     * @brief Moves all elements to *new_begin* inside the current allocation.
+     */
+    void shift_to(pointer new_begin) noexcept{
+        offs.stats().on_shift();
+        count_moves(size());
+        shift_to(new_begin, relocation_tag());
+    }
+
+    void shift_to(pointer new_begin, std::true_type) noexcept{
+        const size_type count = size();
+        relocate(begin_, end_, new_begin);
+        begin_ = new_begin;
+        end_ = new_begin + count;
+    }
+
+    void shift_to(pointer new_begin, std::false_type) noexcept{
+        const size_type count = size();
+        pointer dest = new_begin;
+
+        if(new_begin < begin_){
+            front_shift_while(dest, []{ return true; });
+        }else if(new_begin > begin_){
+            dest += count;
+            back_shift_while(dest, []{ return true; });
+        }
+
+        begin_ = new_begin;
+        end_ = new_begin + count;
+    }
+
+    bool can_recenter() const{
+        return recenter_tag::value && free_total() > offset_by_traits<offset_by_type>::recenter_ratio(offs) * offs.capacity;
+    }
+
+    /**
+     * @brief Makes room for at least one element at the back, either by recentering the elements 
+     * inside the current allocation or by growing it.
+     */
+    void make_room_back(){
+        if(can_recenter()){
+            shift_to(alloc.arr + offset_for(offset_operation::push_back, size() + 1));
+            // Elements only come back to the front by shifting, e.g. in a queue, so its pages can go.
+            discard(alloc.arr, begin_);
+        }else if(!extend(0, next_capacity() - offs.capacity)){
+            reallocate(next_capacity(), offset_operation::push_back, size() + 1);
+        }
+    }
+
+    /**
+     * @brief Makes room for at least one element at the front, either by recentering the elements 
+     * inside the current allocation or by growing it.
+     */
+    void make_room_front(){
+        if(can_recenter()){
+            shift_to(alloc.arr + offset_for(offset_operation::push_front, size() + 1) + 1);
+            discard(end_, alloc.arr + offs.capacity);
+        }else if(!extend(next_capacity() - offs.capacity, 0)){
+            reallocate(next_capacity(), offset_operation::push_front, size() + 1, 1);
+        }
+    }
+
     /**
      * @brief Segregates the container into two parts with a gap of 'n'
      * elements starting at 'pos' while also shifting the container to 
@@ -391,35 +1840,38 @@ private:
      * @return pointer to the first element of the 'n' element gap. 
      */
     pointer segregate(pointer new_begin, pointer new_end, const_iterator pos, size_type n){
-        pointer free_space;
-        buffer_guard front_guard(alloc);
-        buffer_guard back_guard(alloc);
+        offs.stats().on_shift();
+        count_moves((new_begin != begin_ ? pos - begin_ : 0) + (end_ - pos));
+        return segregate(new_begin, new_end, pos, n, relocation_tag());
+    }
 
-        if(!in_bounds(new_begin)){
-            front_guard.guard(new_begin);
-            front_shift_while(front_guard.end, [this, pos]{ return begin_ < pos; });
+    pointer segregate(pointer new_begin, pointer new_end, const_iterator pos, size_type n, std::false_type){
+        const pointer free_space = new_begin + (pos - begin_);
+        buffer_guard front_guard(alloc, new_begin);
+        buffer_guard back_guard(alloc, new_end);
 
-            free_space = front_guard.end;
+        // Each part is walked starting from the end it moves towards, so it never constructs over a live element.
+        if(new_begin < begin_){
+            front_shift_while(front_guard.end, [this, pos]{ return begin_ < pos; });
 
-            if(!in_bounds(front_guard.end + n)){
-                back_guard.guard(front_guard.end + n);
+            if(free_space + n < pos){
+                back_guard.guard(free_space + n);
                 front_shift_while(back_guard.end, []{ return true; });
+            }else if(free_space + n > pos){
+                back_shift_while(back_guard.begin, []{ return true; });
             }else{
-                back_guard.guard(new_end);
-                back_shift_while(back_guard.begin, [this, pos]{ return end_ > pos; });
+                back_guard.guard(begin_, end_);
+                begin_ = end_;
             }
         }else{
-            back_guard.guard(new_end);
             back_shift_while(back_guard.begin, [this, pos]{ return end_ > pos; });
 
-            free_space = back_guard.begin - n;
-
-            if(!in_bounds(back_guard.begin - n - 1)){
-                front_guard.guard(back_guard.begin - n);
+            if(new_begin > begin_){
+                front_guard.guard(free_space);
                 back_shift_while(front_guard.begin, []{ return true; });
             }else{
-                front_guard.guard(new_begin);
-                front_shift_while(front_guard.end, [this, pos]{ return begin_ < pos; });
+                front_guard.guard(begin_, end_);
+                begin_ = end_;
             }
         }
 
@@ -429,6 +1881,79 @@ private:
         return free_space;
     }
 
+    pointer segregate(pointer new_begin, pointer, const_iterator pos, size_type n, std::true_type){
+        const pointer middle = begin_ + (pos - begin_);
+        const pointer free_space = new_begin + (middle - begin_);
+
+        // Move whichever part lies in the direction of the shift first, so neither overwrites the other.
+        if(new_begin > begin_){
+            relocate(middle, end_, free_space + n);
+            relocate(begin_, middle, new_begin);
+        }else{
+            relocate(begin_, middle, new_begin);
+            relocate(middle, end_, free_space + n);
+        }
+
+        begin_ = end_ = new_begin;
+
+        return free_space;
+    }
+
+    /**
+     * @brief Opens a gap of *n* elements at *pos* by shifting [begin, pos) towards the front, 
+     * which there has to be room for. Leaves the container empty like segregate does.
+     * 
+     * @return pointer to the first element of the gap.
+     */
+    pointer open_front(const_iterator pos, size_type n){
+        offs.stats().on_shift();
+        count_moves(pos - begin_);
+        return open_front(pos, n, relocation_tag());
+    }
+
+    pointer open_front(const_iterator pos, size_type n, std::true_type) noexcept{
+        const pointer middle = begin_ + (pos - begin_);
+        relocate(begin_, middle, begin_ - n);
+        begin_ = end_ = middle;
+        return middle - n;
+    }
+
+    pointer open_front(const_iterator pos, size_type n, std::false_type){
+        buffer_guard guard(alloc, begin_ - n);
+        front_shift_while(guard.end, [this, pos]{ return begin_ < pos; });
+        guard.release();
+        begin_ = end_;
+        return guard.end;
+    }
+
+    /**
+     * @brief Opens a gap of *n* elements at *pos* by shifting [pos, end) towards the back, 
+     * which there has to be room for. Leaves the container empty like segregate does.
+     * 
+     * @return pointer to the first element of the gap.
+     */
+    pointer open_back(const_iterator pos, size_type n){
+        offs.stats().on_shift();
+        count_moves(end_ - pos);
+        return open_back(pos, n, relocation_tag());
+    }
+
+    pointer open_back(const_iterator pos, size_type n, std::true_type) noexcept{
+        const pointer middle = begin_ + (pos - begin_);
+        relocate(middle, end_, middle + n);
+        begin_ = end_ = middle;
+        return middle;
+    }
+
+    pointer open_back(const_iterator pos, size_type n, std::false_type){
+        buffer_guard guard(alloc, end_ + n);
+        back_shift_while(guard.begin, [this, pos]{ return end_ > pos; });
+        const pointer free_space = guard.begin - n;
+        guard.release();
+        begin_ = end_;
+        return free_space;
+    }
+
     /**
      * @brief merges two ranges into one, destroying any elements between them.
      * Also shifts the elements in case [new_begin, new_end) isn't inside [begin, end). 
@@ -436,164 +1961,428 @@ private:
      * @return pointer 
      */
     pointer integrate(pointer new_begin, pointer new_end, const_iterator pos, size_type n){
-        pointer ret = new_begin + (pos - begin_);
-        buffer_guard front_guard(alloc);
-        buffer_guard back_guard(alloc);
-        
-        if(!in_bounds(new_begin)){
-            front_guard.guard(new_begin);
+        const size_type front = pos - begin_;
+        offs.stats().on_shift();
+        offs.stats().on_destroy(n);
+        count_moves((new_begin != begin_ ? front : 0) + (new_begin + front != pos + n ? end_ - pos - n : 0));
+        return integrate(new_begin, new_end, pos, n, relocation_tag());
+    }
 
-            while(begin_ < pos){
-                al_traits<allocator_type>::construct(alloc, front_guard.end, *begin_);
-                ++front_guard.end;
-                pop_front();
-            }
+    pointer integrate(pointer new_begin, pointer new_end, const_iterator pos, size_type n, std::true_type){
+        const pointer first = begin_ + (pos - begin_);
+        const pointer last = first + n;
+        const pointer ret = new_begin + (first - begin_);
 
-            while(n--){
-                pop_front();
-            }
+        for(pointer it = first; it != last; ++it){
+            al_traits<allocator_type>::destroy(alloc, it);
+        }
+
+        if(new_begin > begin_){
+            relocate(last, end_, ret);
+            relocate(begin_, first, new_begin);
+        }else{
+            relocate(begin_, first, new_begin);
+            relocate(last, end_, ret);
+        }
+
+        begin_ = new_begin;
+        end_ = new_end;
+
+        return ret;
+    }
+
+    pointer integrate(pointer new_begin, pointer new_end, const_iterator pos, size_type n, std::false_type){
+        const size_type index = pos - begin_;
+
+        // Close the gap first, then move everything over, constructing only into slots that are already free.
+        close_back(pos, n, std::false_type());
+
+        if(new_begin < begin_){
+            buffer_guard guard(alloc, new_begin);
+            front_shift_while(guard.end, []{ return true; });
+            guard.release();
+        }else if(new_begin > begin_){
+            buffer_guard guard(alloc, new_end);
+            back_shift_while(guard.begin, []{ return true; });
+            guard.release();
+        }
+
+        begin_ = new_begin;
+        end_ = new_end;
+
+        return new_begin + index;
+    }
+
+    /**
+     * @brief Erases the *n* elements at *pos* by shifting [begin, pos) towards the back over them.
+     * 
+     * @return pointer to the element following the erased ones.
+     */
+    pointer close_front(const_iterator pos, size_type n){
+        offs.stats().on_shift();
+        offs.stats().on_destroy(n);
+        count_moves(pos - begin_);
+        return close_front(pos, n, relocation_tag());
+    }
+
+    pointer close_front(const_iterator pos, size_type n, std::true_type) noexcept{
+        const pointer first = begin_ + (pos - begin_);
+        for(pointer it = first; it != first + n; ++it){
+            al_traits<allocator_type>::destroy(alloc, it);
+        }
+
+        relocate(begin_, first, begin_ + n);
+        begin_ += n;
+
+        return first + n;
+    }
+
+    pointer close_front(const_iterator pos, size_type n, std::false_type){
+        const pointer last = begin_ + (pos - begin_) + n;
+        std::move_backward(begin_, last - n, last);
+        while(n--){
+            destroy_front();
+        }
+
+        return last;
+    }
+
+    /**
+     * @brief Erases the *n* elements at *pos* by shifting [pos + n, end) towards the front over them.
+     * 
+     * @return pointer to the element following the erased ones.
+     */
+    pointer close_back(const_iterator pos, size_type n){
+        offs.stats().on_shift();
+        offs.stats().on_destroy(n);
+        count_moves(end_ - pos - n);
+        return close_back(pos, n, relocation_tag());
+    }
+
+    pointer close_back(const_iterator pos, size_type n, std::true_type) noexcept{
+        const pointer first = begin_ + (pos - begin_);
+        for(pointer it = first; it != first + n; ++it){
+            al_traits<allocator_type>::destroy(alloc, it);
+        }
+
+        relocate(first + n, end_, first);
+        end_ -= n;
+
+        return first;
+    }
+
+    pointer close_back(const_iterator pos, size_type n, std::false_type){
+        const pointer first = begin_ + (pos - begin_);
+        std::move(first + n, end_, first);
+        while(n--){
+            destroy_back();
+        }
+
+        return first;
+    }
+
+    /**
+     * @brief Destroys [first, last), closing the gap from whichever side the policies choose.
+     */
+    iterator erase_range(const_iterator first, const_iterator last){
+        if(first == begin_){
+            pop_front_n(last - first);
+            return begin_;
+        }else if(last == end_){
+            pop_back_n(last - first);
+            return end_;
+        }else{
+            const size_type n = last - first;
 
-            while(!empty()){
-                al_traits<allocator_type>::construct(alloc, front_guard.end, *begin_);
-                ++front_guard.end;
-                pop_front();
+            if(!n){
+                return begin_ + (first - begin_);
             }
-        }else if(!in_bounds(new_end)){
-            back_guard.guard(new_end);
 
-            while(end_ < pos + n){
-                al_traits<allocator_type>::construct(alloc, back_guard.begin - 1, end_[-1]);
-                --back_guard.begin;
-                pop_back();
+            if(offset_by_traits<offset_by_type>::shift_shorter_side(offs)){
+                return first - begin_ < end_ - last ? close_front(first, n) : close_back(first, n);
             }
 
-            while(n--){
-                pop_back();
+            const pointer new_begin = alloc.arr + offset_for(offset_operation::erase, size() - n);
+            const pointer new_end = new_begin + size() - n;
+
+            return integrate(new_begin, new_end, first, n);
+        }
+    }
+
+
+    size_type capacity_to_fit(size_type n) const{
+        if(n > max_size()){
+            throw std::length_error("devector cannot grow past max_size()");
+        }
+        return offs.growth().capacity_to_fit(offs.capacity, n, max_size());
+    }
+
+    /**
+     * @brief Reallocates to fit *n* more elements, inserting them at *position* on the way.
+     * 
+     * @return pointer to the first newly-created element.
+     */
+    template<class Insert>
+    pointer reallocate_insert(const_iterator position, size_type n, Insert ins, offset_operation operation, std::false_type){
+        const size_type new_size = size() + n;
+
+        memory_guard mem_guard(alloc, capacity_to_fit(new_size));
+        offs.stats().on_allocate(mem_guard.capacity, mem_guard.capacity * sizeof(value_type));
+        
+        const size_type front_space = offset_for(operation, new_size, mem_guard.capacity);
+
+        buffer_guard buf_guard(alloc, mem_guard.arr + front_space);
+
+        auto it = begin();
+        for(; it < position; ++it){
+            al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*it));
+            ++buf_guard.end;
+        }
+
+        const pointer pos = buf_guard.end;
+        construct_each(buf_guard.end, n, ins);
+        for(; it < end(); ++it){
+            al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*it));
+            ++buf_guard.end;
+        }
+
+        const size_type moved = size();
+        destroy_moved();
+        deallocate();
+
+        alloc.arr = mem_guard.arr;
+        offs.capacity = mem_guard.capacity;
+        offs.stats().on_reallocate();
+        count_moves(moved);
+
+        begin_ = buf_guard.begin;
+        end_ = buf_guard.end;
+
+        buf_guard.release();
+        mem_guard.release();
+
+        return pos;
+    }
+
+    template<class Insert>
+    pointer reallocate_insert(const_iterator position, size_type n, Insert ins, offset_operation operation, std::true_type){
+        const size_type new_size = size() + n;
+        const pointer middle = begin_ + (position - begin_);
+
+        memory_guard mem_guard(alloc, capacity_to_fit(new_size));
+        offs.stats().on_allocate(mem_guard.capacity, mem_guard.capacity * sizeof(value_type));
+        
+        const pointer new_begin = mem_guard.arr + offset_for(operation, new_size, mem_guard.capacity);
+
+        // The new elements are constructed first, that way the old buffer stays intact if any of them throws.
+        buffer_guard buf_guard(alloc, new_begin + (middle - begin_));
+        construct_each(buf_guard.end, n, ins);
+
+        relocate(begin_, middle, new_begin);
+        relocate(middle, end_, buf_guard.end);
+
+        const pointer new_end = buf_guard.end + (end_ - middle);
+        deallocate();
+
+        alloc.arr = mem_guard.arr;
+        offs.capacity = mem_guard.capacity;
+        offs.stats().on_reallocate();
+        count_moves(size());
+
+        begin_ = new_begin;
+        end_ = new_end;
+
+        const pointer pos = buf_guard.begin;
+        buf_guard.release();
+        mem_guard.release();
+
+        return pos;
+    }
+
+    /**
+     * @brief Calls ins on the *n* slots starting at *end*, which ends up past the last one constructed, even if one throws.
+     * Counting in a local lets the loop vanish when constructing is a no-op.
+     */
+    template<class Insert>
+    static void construct_each(pointer& end, size_type n, Insert& ins){
+        pointer p = end;
+        try{
+            for(const pointer last = p + n; p != last; ++p){
+                ins(p);
             }
+        }catch(...){
+            end = p;
+            throw;
+        }
+        end = p;
+    }
 
-            while(!empty()){
-                al_traits<allocator_type>::construct(alloc, back_guard.begin - 1, end_[-1]);
-                --back_guard.begin;
-                pop_back();
-            }
+    /**
+     * @brief Inserts *n* elements at *position*, which there has to be room for.
+     */
+    template<class Insert>
+    iterator insert_in_place(const_iterator position, size_type n, Insert ins, offset_operation operation){
+        if(position == begin_ && free_front() >= n){
+            buffer_guard front_guard(alloc, begin_ - n);
+            construct_each(front_guard.end, n, ins);
+            begin_ = front_guard.begin;
+            front_guard.release();
+            return begin_;
+        }else if(position == end_ && free_back() >= n){
+            const pointer pos = end_;
+            construct_each(end_, n, ins);
+            return pos;
         }else{
-            auto const front_shift = new_begin - begin_;
-            auto const back_shift = end_ - new_end;
-
-            while(begin_ < pos){
-                begin_[front_shift] = std::move(*begin_);
-                pop_front();
+            const size_type count = size();
+            const bool front_room = free_front() >= n;
+            const bool back_room = free_back() >= n;
+
+            pointer new_begin;
+            pointer free_space;
+
+            // Shifting either side moves fewer elements than recentering, the shorter one is preferred.
+            if(offset_by_traits<offset_by_type>::shift_shorter_side(offs) && (front_room || back_room)){
+                if(front_room && (!back_room || position - begin_ <= end_ - position)){
+                    new_begin = begin_ - n;
+                    free_space = open_front(position, n);
+                }else{
+                    new_begin = begin_;
+                    free_space = open_back(position, n);
+                }
+            }else{
+                new_begin = alloc.arr + offset_for(operation, count + n);
+                free_space = segregate(new_begin, new_begin + n + count, position, n);
             }
 
-            while(begin_ < new_begin){
-                pop_front();
-            }
+            const pointer new_end = new_begin + n + count;
 
-            while(end_ > pos + n){
-                end_[-back_shift - 1] = std::move(end_[-1]);
-                pop_back();
-            }
+            buffer_guard front_guard(alloc, new_begin, free_space);
+            buffer_guard back_guard(alloc, free_space + n, new_end);
 
-            while(end_ > new_end){
-                pop_back();
-            }
-        }
+            construct_each(front_guard.end, n, ins);
 
-        begin_ = new_begin;
-        end_ = new_end;
-        front_guard.release();
-        back_guard.release();
+            begin_ = new_begin;
+            end_ = new_end;
 
-        return ret;
-    }
+            front_guard.release();
+            back_guard.release();
 
-    size_type capacity_to_fit(size_type n) const noexcept{
-        float temp_capacity = offs.capacity ? offs.capacity : 1;
-        while(temp_capacity < n){
-            temp_capacity = factor * temp_capacity;
+            return free_space;
         }
-        return static_cast<size_type>(temp_capacity);
     }
 
+    /**
+     * @brief Constructs *n* elements at *position* through *ins*, called once per slot in order, 
+     * growing at most once. *operation* is what OffsetBy is told if the elements have to be moved.
+     */
     template<class Insert>
-    iterator insert_impl(const_iterator position, size_type n, Insert ins){
+    iterator insert_impl(const_iterator position, size_type n, Insert ins, offset_operation operation = offset_operation::insert){
         iterator pos; // position of first newly-created element
 
-        if(n <= free_total()){
-            if(position == begin_){
-                buffer_guard front_guard(alloc, begin_ - n);
-                while(n--){
-                    ins(front_guard.end);
-                    ++front_guard.end;
-                }
-                begin_ = front_guard.begin;
-                front_guard.release();
-            }else if(position == end_){
-                while(n--){
-                    ins(end_);
-                    ++end_;
-                }
-            }else{
-                const pointer new_begin = alloc.arr + offs.off_by(free_total() - n);
-                const pointer new_end = new_begin + n + size();
-
-                const pointer free_space = segregate(new_begin, new_end, position, n);
+        if(!n){
+            return begin_ + (position - begin_);
+        }
 
-                buffer_guard front_guard(alloc, new_begin, free_space);
-                buffer_guard back_guard(alloc, free_space + n, new_end);
+        if(position == begin_){
+            offset_by_traits<offset_by_type>::on_push_front(offs, n);
+        }else if(position == end_){
+            offset_by_traits<offset_by_type>::on_push_back(offs, n);
+        }
 
-                while(n--){
-                    ins(front_guard.end);
-                    ++front_guard.end;
-                }
+        // Shifting elements makes room at an end as long as plenty is free, only then is an extensible block grown in place.
+        const size_type index = position - begin_;
+        const size_type room = index == size() ? free_back() : !index ? free_front() : free_total();
+        const bool fits = n <= free_total();
 
-                begin_ = new_begin;
-                end_ = new_end;
+        if(n <= room || (fits && can_recenter()) || extend_for(index, n) || fits){
+            pos = insert_in_place(position, n, ins, operation);
+        }else if(in_place_tag::value && offs.capacity){
+            // Grow the allocation itself, leaving room at the front if that's where the elements go.
+            const size_type new_size = size() + n;
+            const size_type new_capacity = capacity_to_fit(new_size);
+            reallocate(new_capacity, operation, new_size, index ? 0 : n);
+            pos = insert_in_place(begin_ + index, n, ins, operation);
+        }else{
+            pos = reallocate_insert(position, n, ins, operation, relocation_tag());
+        }
 
-                front_guard.release();
-                back_guard.release();
+        offs.stats().on_construct(n);
+        return pos;
+    }
 
-                pos = free_space;
-            }
-        }else{
-            const size_type new_size = size() + n;
+    iterator insert_fill(const_iterator position, size_type n, const_reference val, std::true_type){
+        // The gap is opened first & filled at once, val may lie inside the part that gets shifted.
+        const value_type copy = val;
+        const iterator pos = insert_impl(position, n, [](pointer){});
+        fill(pos, n, copy);
+        return pos;
+    }
 
-            memory_guard mem_guard(alloc, capacity_to_fit(new_size));
-            
-            const size_type front_space = offs.off_by(mem_guard.capacity - new_size);
+    iterator insert_fill(const_iterator position, size_type n, const_reference val, std::false_type){
+        return insert_impl(position, n, [&val, this](pointer p){
+            al_traits<allocator_type>::construct(alloc, p, val);
+        });
+    }
 
-            buffer_guard buf_guard(alloc, mem_guard.arr + front_space);
+    template<class Range>
+    static auto range_size(const Range& rg, int) -> decltype(static_cast<size_type>(rg.size())){
+        return rg.size();
+    }
 
-            auto it = begin();
-            for(; it < position; ++it){
-                al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*it));
-                ++buf_guard.end;
-            }
+    template<class Range>
+    static size_type range_size(const Range& rg, long){
+        return std::distance(std::begin(rg), std::end(rg));
+    }
 
-            pos = buf_guard.end;
-            while(n--){
-                ins(buf_guard.end);
-                ++buf_guard.end;
-            }
-            for(; it < end(); ++it){
-                al_traits<allocator_type>::construct(alloc, buf_guard.end, std::move_if_noexcept(*it));
-                ++buf_guard.end;
-            }
+    template<class Range>
+    iterator insert_range_impl(const_iterator position, Range& rg, offset_operation operation, std::true_type){
+        auto first = std::begin(rg);
+        return insert_impl(position, range_size(rg, 0), [&first, this](pointer p){
+            al_traits<allocator_type>::construct(alloc, p, *first);
+            ++first;
+        }, operation);
+    }
 
-            destroy_all();
-            deallocate();
+    template<class Range>
+    iterator insert_range_impl(const_iterator position, Range& rg, offset_operation, std::false_type){
+        return insert_unsized(position, std::begin(rg), std::end(rg));
+    }
 
-            alloc.arr = mem_guard.arr;
-            offs.capacity = mem_guard.capacity;
+    /**
+     * @brief Inserts [first, last) at *position* without knowing their count beforehand. They're pushed at the front if that's
+     * where they go, at the back & rotated into place otherwise. Nothing is inserted if any of them throws.
+     */
+    template<class InputIterator>
+    iterator insert_unsized(const_iterator position, InputIterator first, InputIterator last){
+        const size_type index = position - begin_;
+        const size_type old_size = size();
+        const bool front = !index && old_size;
 
-            begin_ = buf_guard.begin;
-            end_ = buf_guard.end;
+        try{
+            for(; first != last; ++first){
+                if(front){
+                    push_front(*first);
+                }else{
+                    push_back(*first);
+                }
+            }
+        }catch(...){
+            if(front){
+                erase(begin_, begin_ + (size() - old_size));
+            }else{
+                erase(begin_ + old_size, end_);
+            }
+            throw;
+        }
 
-            buf_guard.release();
-            mem_guard.release();
+        if(front){
+            std::reverse(begin_, begin_ + (size() - old_size));
+        }else if(index != old_size){
+            std::rotate(begin_ + index, begin_ + old_size, end_);
+            count_moves(size() - index);
         }
 
-        return pos;
+        return begin_ + index;
     }
 
 public:
@@ -619,7 +2408,7 @@ public:
     {
         alloc.arr = allocate_n(n);
         try{
-            construct(n, val);
+            construct(n, val, offset_operation::construct);
         }catch(...){
             destroy_all();
             deallocate();
@@ -657,7 +2446,7 @@ public:
     {
        alloc.arr = allocate_n(distance);
        try{
-           construct(first, distance);
+           construct(first, distance, offset_operation::construct);
        }catch(...){
            destroy_all();
            deallocate();
@@ -688,7 +2477,7 @@ public:
             const size_type distance = std::distance(first, last);
             alloc.arr = allocate_n(distance);
             try{
-                construct(first, distance);
+                construct(first, distance, offset_operation::construct);
             }catch(...){
                 destroy_all();
                 deallocate();
@@ -713,14 +2502,16 @@ public:
 
     devector(const devector& x, const allocator_type& allocator, const offset_by_type& offset_by)
     :devector(x.begin(), x.end(), x.size(), allocator, offset_by)
-    {}
+    {
+        offs.growth() = x.offs.growth();
+    }
 
     devector(const devector& x, const allocator_type& allocator)
-    :devector(x.begin(), x.end(), x.size(), allocator, x.offs)
+    :devector(x, allocator, x.offs)
     {}
 
     devector(const devector& x, const offset_by_type& offset_by)
-    :devector(x.begin(), x.end(), x.size(), x.alloc, offset_by)
+    :devector(x, x.alloc, offset_by)
     {}
 
     devector(const devector& x)
@@ -732,16 +2523,14 @@ public:
     {}
 
     devector(devector&& x, const allocator_type& allocator, const offset_by_type& offset_by) noexcept
-    :offs(offset_by)
+    :alloc(allocator), offs(offset_by)
     {
-        if(allocator == x.alloc){
-            alloc.get() = x.alloc.get();
+        offs.growth() = x.offs.growth();
+        if(alloc == x.alloc){
             steal_ownership(x);
         }else{
-            alloc.get() = allocator;
-
             alloc.arr = allocate_n(x.size());
-            construct_move(x.begin(), x.size());
+            construct_move(x.begin(), x.size(), offset_operation::construct);
         }
     }
 
@@ -765,6 +2554,58 @@ public:
     :devector(il.begin(), il.end(), il.size(), allocator_type(), offset_by)
     {}
 
+    /**
+     * @brief Takes over *capacity* slots at *arr*, allocated by *allocator*, of which [offset, offset + size) already hold live elements.
+     * Nothing is allocated, copied or constructed.
+     */
+    devector(
+        adopt_buffer_t,
+        pointer arr,
+        size_type capacity,
+        size_type offset,
+        size_type size,
+        const allocator_type& allocator = allocator_type(),
+        const offset_by_type& offset_by = offset_by_type()
+    )
+    :alloc(allocator), offs(offset_by)
+    {
+        alloc.arr = arr;
+        offs.capacity = capacity;
+        begin_ = arr + offset;
+        end_ = begin_ + size;
+        offs.stats().on_construct(size);
+    }
+
+    /**
+     * @brief Takes over a buffer, like one handed out by release(), that *allocator* can deallocate.
+     */
+    devector(
+        adopt_buffer_t,
+        const raw_buffer& buffer,
+        const allocator_type& allocator = allocator_type(),
+        const offset_by_type& offset_by = offset_by_type()
+    )
+    :devector(adopt_buffer, buffer.arr, buffer.capacity, buffer.begin - buffer.arr, buffer.end - buffer.begin, allocator, offset_by)
+    {}
+
+    /**
+     * @brief Moves the elements of *vec* over, sharing its allocator, and frees its storage.
+     * std::vector can't hand its buffer over, trivially copyable elements are copied with a single memcpy instead.
+     */
+    explicit devector(std::vector<value_type, allocator_type>&& vec, const offset_by_type& offset_by = offset_by_type())
+    :devector(vec.get_allocator(), offset_by)
+    {
+        alloc.arr = allocate_n(vec.size());
+        try{
+            construct_move(vec.data(), vec.size(), offset_operation::construct);
+        }catch(...){
+            destroy_all();
+            deallocate();
+            throw;
+        }
+        std::vector<value_type, allocator_type>(vec.get_allocator()).swap(vec);
+    }
+
     ~devector(){
         destroy_all();
         deallocate();
@@ -774,18 +2615,18 @@ public:
     void assign (InputIterator first, size_type distance){
         destroy_all();
         if(offs.capacity < distance){
-            reallocate(capacity_to_fit(distance));
+            reallocate(capacity_to_fit(distance), offset_operation::assign);
         }
-        construct(first, distance);
+        construct(first, distance, offset_operation::assign);
     }
 
     template<class InputIterator, is_iterator<InputIterator> = 0>
     void assign (InputIterator first, InputIterator last){
-        if(is_at_least_forward<InputIterator>::value){
+        if(is_at_least_forward<typename it_traits<InputIterator>::iterator_category>::value){
             assign(first, std::distance(first,last));
         }else{
             destroy_all();
-            begin_ = end_ = alloc.arr + offs.off_by(free_total());
+            begin_ = end_ = alloc.arr + offset_for(offset_operation::assign, 0);
             while(first != last){
                 push_back(*first);
                 ++first;
@@ -796,17 +2637,17 @@ public:
     void assign(size_type n, const_reference val){
         destroy_all();
         if(offs.capacity < n){
-            reallocate(capacity_to_fit(n));
+            reallocate(capacity_to_fit(n), offset_operation::assign);
         }
-        construct(n, val);
+        construct(n, val, offset_operation::assign);
     }
 
     void assign(std::initializer_list<value_type> il){
         destroy_all();
         if(offs.capacity < il.size()){
-            reallocate(capacity_to_fit(il.size()));
+            reallocate(capacity_to_fit(il.size()), offset_operation::assign);
         }
-        construct(il.begin(), il.size());
+        construct(il.begin(), il.size(), offset_operation::assign);
     }
 
     devector& operator=(const devector& x){
@@ -815,47 +2656,25 @@ public:
         }
 
         offs.get() = x.offs.get();
+        offs.growth() = x.offs.growth();
 
         if(al_traits<allocator_type>::propagate_on_container_copy_assignment::value && alloc != x.alloc){            
             destroy_all();
             deallocate();
             
-            alloc.get() = x.alloc.get();
+            propagate_allocator(x.alloc.get(), typename al_traits<allocator_type>::propagate_on_container_copy_assignment());
 
             alloc.arr = allocate_n(capacity_to_fit(x.size()));
-            construct(x.begin(), x.size());
+            construct(x.begin(), x.size(), offset_operation::assign);
 
         }else{
             if(offs.capacity < x.size()){
                 destroy_all();
                 deallocate();
                 alloc.arr = allocate_n(capacity_to_fit(x.size()));
-                construct(x.begin(), x.size());
+                construct(x.begin(), x.size(), offset_operation::assign);
             }else{
-                const pointer new_begin = alloc.arr + offs.off_by(offs.capacity - x.size());
-                const pointer new_end = new_begin + x.size();
-
-                while(!empty() && begin_ < new_begin){
-                    pop_front();
-                }
-                
-                while(!empty() && end_ > new_end){
-                    pop_back();
-                }
-
-                buffer_guard guard(alloc, new_begin);
-
-                for(auto it = x.begin_; it != x.end_; ++it, ++guard.end){
-                    if(in_bounds(guard.end)){
-                        *guard.end = *it;
-                    }else{
-                        al_traits<allocator_type>::construct(alloc, guard.end, *it);
-                    }
-                }
-
-                begin_ = new_begin;
-                end_ = new_end;
-                guard.release();
+                assign_over(x.begin_, x.size());
             }
         }
 
@@ -869,39 +2688,24 @@ public:
         }
 
         offs.get() = std::move(x.offs.get());
+        offs.growth() = std::move(x.offs.growth());
 
         if(!al_traits<allocator_type>::propagate_on_container_move_assignment::value){
             if(alloc != x.alloc){
                 if(offs.capacity < x.size()){
                     destroy_all();
                     deallocate();
-                    alloc.arr = allocate_n(capacity_to_fit(x.size()));
-                    construct_move(x.begin_, x.size());
-                }else{
-                    const pointer new_begin = alloc.arr + offs.off_by(offs.capacity - x.size());
-                    const pointer new_end = new_begin + x.size();
-
-                    while(!empty() && begin_ < new_begin){
-                        pop_front();
-                    }
-                    
-                    while(!empty() && end_ > new_end){
-                        pop_back();
-                    }
-
-                    buffer_guard guard(alloc, new_begin);
-
-                    for(auto it = x.begin_; it != x.end_; ++it, ++guard.end){
-                        if(in_bounds(guard.end)){
-                            *guard.end = std::move(*it);
-                        }else{
-                            al_traits<allocator_type>::construct(alloc, guard.end, std::move(*it));
-                        }
+                    // Allocators such as small_buffer_allocator compare equal once their own storage is released.
+                    if(alloc == x.alloc){
+                        steal_ownership(x);
+                    }else{
+                        alloc.arr = allocate_n(capacity_to_fit(x.size()));
+                        construct_move(x.begin_, x.size(), offset_operation::assign);
                     }
-
-                    begin_ = new_begin;
-                    end_ = new_end;
-                    guard.release();
+                }else if(bulk_tag::value){
+                    assign_over(x.begin_, x.size());
+                }else{
+                    assign_over(std::make_move_iterator(x.begin_), x.size());
                 }
             }else{
                 destroy_all();
@@ -912,7 +2716,7 @@ public:
             destroy_all();
             deallocate();
             steal_ownership(x);
-            alloc.get() = std::move(x.alloc.get());
+            propagate_allocator(std::move(x.alloc.get()), typename al_traits<allocator_type>::propagate_on_container_move_assignment());
         }
         
         return *this;
@@ -923,58 +2727,61 @@ public:
             destroy_all();
             deallocate();
             alloc.arr = allocate_n(capacity_to_fit(il.size()));
-            construct(il.begin(), il.size());
+            construct(il.begin(), il.size(), offset_operation::assign);
         }else{
-            const pointer new_begin = alloc.arr + offs.off_by(offs.capacity - il.size());
-            const pointer new_end = new_begin + il.size();
-
-            while(!empty() && begin_ < new_begin){
-                pop_front();
-            }
-            
-            while(!empty() && end_ > new_end){
-                pop_back();
-            }
-
-            buffer_guard guard(alloc, new_begin);
-
-            for(auto it = il.begin(); it != il.end(); ++it, ++guard.end){
-                if(in_bounds(guard.end)){
-                    *guard.end = *it;
-                }else{
-                    al_traits<allocator_type>::construct(alloc, guard.end, *it);
-                }
-            }
-
-            begin_ = new_begin;
-            end_ = new_begin + il.size();
-            guard.release();
+            assign_over(il.begin(), il.size());
         }
 
         return *this;
     }
 
     void resize_front(size_type n, const_reference val = value_type()){
-        while(n < size()){
-            pop_front();
-        }
-        if(n > offs.capacity){
-            reallocate(capacity_to_fit(n), free_back());
-        }
-        while(n > size()){
-            push_front(val);
+        if(n < size()){
+            pop_front_n(size() - n);
+            shrink_if_sparse();
+        }else{
+            insert_impl(begin_, n - size(), [&val, this](pointer p){
+                al_traits<allocator_type>::construct(alloc, p, val);
+            }, offset_operation::resize_front);
         }
     }
 
     void resize_back(size_type n, const_reference val = value_type()){
-        while(n < size()){
-            pop_back();
+        if(n < size()){
+            pop_back_n(size() - n);
+            shrink_if_sparse();
+        }else{
+            insert_impl(end_, n - size(), [&val, this](pointer p){
+                al_traits<allocator_type>::construct(alloc, p, val);
+            }, offset_operation::resize_back);
         }
-        if(n > offs.capacity){
-            reallocate(capacity_to_fit(n), free_front());
+    }
+
+    /**
+     * @brief Like resize_front, but new elements are default-initialized, so trivial types are left uninitialized for the caller to overwrite.
+     */
+    void resize_front_for_overwrite(size_type n){
+        if(n < size()){
+            pop_front_n(size() - n);
+            shrink_if_sparse();
+        }else{
+            insert_impl(begin_, n - size(), [this](pointer p){
+                construct_for_overwrite(p);
+            }, offset_operation::resize_front);
         }
-        while(n > size()){
-            push_back(val);
+    }
+
+    /**
+     * @brief Like resize_back, but new elements are default-initialized, so trivial types are left uninitialized for the caller to overwrite.
+     */
+    void resize_back_for_overwrite(size_type n){
+        if(n < size()){
+            pop_back_n(size() - n);
+            shrink_if_sparse();
+        }else{
+            insert_impl(end_, n - size(), [this](pointer p){
+                construct_for_overwrite(p);
+            }, offset_operation::resize_back);
         }
     }
 
@@ -983,13 +2790,19 @@ public:
     }
   
     void reserve(size_type n){
-        if(n > offs.capacity){
-            reallocate(n);
+        if(n > offs.capacity && !extend(0, n - offs.capacity)){
+            reallocate(n, offset_operation::reserve);
         }
     }
 
+    /**
+     * @brief Reallocates to exactly size() slots, unless the container already is that tight.
+     */
     void shrink_to_fit(){
-        reallocate(size());
+        if(is_inline() || is_tight()){
+            return;
+        }
+        shrink(size());
     }
 
     reference operator[](size_type index){
@@ -1040,66 +2853,57 @@ public:
         return alloc.arr;
     }
 
-    void push_back(const_reference val){
-        if(!free_back()){
-            const auto new_capacity = next_capacity();
-            auto offset = offs.off_by(new_capacity - size());
-            offset -= offset == (new_capacity - size());
-            reallocate(new_capacity, offset);
-        }
+    /**
+     * @brief Returns the first element equal to *val*, or end(). Byte comparable elements are searched a vector register at a time.
+     */
+    iterator find(const_reference val){
+        return begin_ + simd::find(begin_, size(), val, simd::search_tag<pointer>());
+    }
 
-        al_traits<allocator_type>::construct(alloc, end_, val);
-        ++end_;
+    const_iterator find(const_reference val) const{
+        return begin_ + simd::find(begin_, size(), val, simd::search_tag<pointer>());
     }
 
-    void push_back(value_type&& val){
-        if(!free_back()){
-            const auto new_capacity = next_capacity();
-            auto offset = offs.off_by(new_capacity - size());
-            offset -= offset == (new_capacity - size());
-            reallocate(new_capacity, offset);
-        }
+    size_type count(const_reference val) const{
+        return simd::count(begin_, size(), val, simd::search_tag<pointer>());
+    }
 
-        al_traits<allocator_type>::construct(alloc, end_, std::move(val));
-        ++end_;
+    bool contains(const_reference val) const{
+        return find(val) != end();
     }
 
-    void push_front(const_reference val){
-        if(!free_front()){
-            const auto new_capacity = next_capacity();
-            const auto offset = offs.off_by(new_capacity - size());
-            reallocate(new_capacity, offset + !offset);
-        }
+    void push_back(const_reference val){
+        emplace_back(val);
+    }
 
-        al_traits<allocator_type>::construct(alloc, begin_.ptr - 1, val);
-        --begin_;
+    void push_back(value_type&& val){
+        emplace_back(std::move(val));
     }
 
-    void push_front(value_type&& val){
-        if(!free_front()){
-            const auto new_capacity = next_capacity();
-            const auto offset = offs.off_by(new_capacity - size());
-            reallocate(new_capacity, offset + !offset);
-        }
+    void push_front(const_reference val){
+        emplace_front(val);
+    }
 
-        al_traits<allocator_type>::construct(alloc, begin_ - 1, std::move(val));
-        --begin_;
+    void push_front(value_type&& val){
+        emplace_front(std::move(val));
     }
 
     void pop_back() noexcept{
-        al_traits<allocator_type>::destroy(alloc, end_ - 1);
-        --end_;
+        offset_by_traits<offset_by_type>::on_pop_back(offs, 1);
+        offs.stats().on_destroy(1);
+        destroy_back();
+        shrink_if_sparse();
     }
 
     void pop_front() noexcept{
-        al_traits<allocator_type>::destroy(alloc, begin_);
-        ++begin_;
+        offset_by_traits<offset_by_type>::on_pop_front(offs, 1);
+        offs.stats().on_destroy(1);
+        destroy_front();
+        shrink_if_sparse();
     }
 
     iterator insert(const_iterator position, size_type n, const_reference val){
-        return insert_impl(position, n, [&val, this](pointer p){
-            al_traits<allocator_type>::construct(alloc, p, val);
-        });
+        return insert_fill(position, n, val, bulk_tag());
     }
 
     iterator insert(const_iterator position, const_reference val){
@@ -1124,29 +2928,33 @@ public:
         if(is_at_least_forward<typename it_traits<InputIterator>::iterator_category>::value){
             return insert(position, first, std::distance(first, last));
         }else{
-            const auto index = position - cbegin();
-            memory_guard mem_guard(alloc, cend() - position + 1);
-            buffer_guard buf_guard(alloc, mem_guard.arr + mem_guard.capacity - 1);
-
-            while(buf_guard.begin != mem_guard.arr){
-                al_traits<allocator_type>::construct(alloc, buf_guard.begin - 1, std::move(back()));
-                --buf_guard.begin;
-                pop_back();
-            }
+            return insert_unsized(position, first, last);
+        }
+    }
 
-            while(first != last){
-                push_back(*first);
-                ++first;
-            }
+    /**
+     * @brief Inserts the elements of *rg* at *position*. When their count is known beforehand, through a size() member or forward iterators,
+     * the container grows at most once & every element is constructed right into its final slot.
+     */
+    template<class Range>
+    iterator insert_range(const_iterator position, Range&& rg){
+        return insert_range_impl(position, rg, offset_operation::insert, std::integral_constant<bool, is_sized_range<Range>::value>());
+    }
 
-            reserve(capacity() + buf_guard.end - buf_guard.begin);
-            for(pointer it = buf_guard.begin; it != buf_guard.end; ++it){
-                al_traits<allocator_type>::construct(alloc, end_, std::move(*it));
-                ++end_;
-            }
-            
-            return begin_ + index;
-        }
+    /**
+     * @brief Appends the elements of *rg*, like insert_range at end() but telling OffsetBy it's a *push_back* if growing.
+     */
+    template<class Range>
+    void append_range(Range&& rg){
+        insert_range_impl(end_, rg, offset_operation::push_back, std::integral_constant<bool, is_sized_range<Range>::value>());
+    }
+
+    /**
+     * @brief Prepends the elements of *rg* keeping their order, like insert_range at begin() but telling OffsetBy it's a *push_front* if growing.
+     */
+    template<class Range>
+    void prepend_range(Range&& rg){
+        insert_range_impl(begin_, rg, offset_operation::push_front, std::integral_constant<bool, is_sized_range<Range>::value>());
     }
 
     iterator insert(const_iterator position, std::initializer_list<value_type> il){
@@ -1154,47 +2962,44 @@ public:
     }
 
     iterator erase(const_iterator first, const_iterator last){
-        iterator pos;
-
-        if(first == begin_){
-            while(begin_ < last){
-                al_traits<allocator_type>::destroy(alloc, begin_);
-                ++begin_;
-            }
-            return begin_;
-        }else if(last == end_){
-            while(end_ > first){
-                al_traits<allocator_type>::destroy(alloc, end_ - 1);
-                --end_;
-            }
-            return end_;
-        }else{
-            const size_type n = last - first;
-
-            const pointer new_begin = alloc.arr + offs.off_by(free_total() + n);
-            const pointer new_end = new_begin + size() - n;
-
-            return integrate(new_begin, new_end, first, n);
-        }
+        // Whichever side moved, the element following the erased ones ends up at the first one's index.
+        const size_type index = first - begin_;
+        erase_range(first, last);
+        shrink_if_sparse();
+        return begin_ + index;
     }
 
     iterator erase(const_iterator position){
         return erase(position, position + 1);
     }
 
+    /**
+     * @brief Exchanges the elements & policies of both containers, statistics stay with the container they were gathered by.
+     * Allocators are exchanged only if propagate_on_container_swap holds, otherwise elements are moved one by one
+     * when they compare unequal.
+     */
     void swap(devector& x){
-        std::swap(alloc.arr, x.alloc.arr);
-        std::swap(begin_, x.begin_);
-        std::swap(end_, x.end_);
-        std::swap(offs.capacity, x.offs.capacity);
-        std::swap(offs, x.offs);
-        if(al_traits<allocator_type>::propagate_on_container_swap){
-            std::swap(alloc, x.alloc);
+        // Buffers can't change hands between allocators that stay put & compare unequal, their elements are moved instead.
+        if(!al_traits<allocator_type>::propagate_on_container_swap::value && alloc != x.alloc){
+            devector temp(std::move(x));
+            x = std::move(*this);
+            *this = std::move(temp);
+            return;
         }
+
+        using std::swap;
+        swap(alloc.arr, x.alloc.arr);
+        swap(begin_, x.begin_);
+        swap(end_, x.end_);
+        swap(offs.capacity, x.offs.capacity);
+        swap(offs.get(), x.offs.get());
+        swap(offs.growth(), x.offs.growth());
+        swap_allocator(x, typename al_traits<allocator_type>::propagate_on_container_swap());
     }
 
     void clear() noexcept{
         destroy_all();
+        shrink_if_sparse();
     }
 
     template<class... Args>
@@ -1206,29 +3011,66 @@ public:
 
     template<class... Args>
     iterator emplace_back(Args&&... args){
-        if(!free_back()){
-            const auto new_capacity = next_capacity();
-            auto offset = offs.off_by(new_capacity - size());
-            offset -= offset == (new_capacity - size());
-            reallocate(new_capacity, offset);
+        offset_by_traits<offset_by_type>::on_push_back(offs, 1);
+        if(free_back()){
+            al_traits<allocator_type>::construct(alloc, end_, std::forward<Args>(args)...);
+        }else{
+            // args may refer to an element, which making room shifts or moves away, so they're read first.
+            value_type val(std::forward<Args>(args)...);
+            make_room_back();
+            al_traits<allocator_type>::construct(alloc, end_, std::move(val));
         }
 
-        al_traits<allocator_type>::construct(alloc, end_, std::forward<Args>(args)...);
+        offs.stats().on_construct(1);
         return end_++;
     }
 
     template<class... Args>
     iterator emplace_front(Args&&... args){
-        if(!free_front()){
-            const auto new_capacity = next_capacity();
-            const auto offset = offs.off_by(new_capacity - size());
-            reallocate(new_capacity, offset + !offset);
+        offset_by_traits<offset_by_type>::on_push_front(offs, 1);
+        if(free_front()){
+            al_traits<allocator_type>::construct(alloc, begin_ - 1, std::forward<Args>(args)...);
+        }else{
+            value_type val(std::forward<Args>(args)...);
+            make_room_front();
+            al_traits<allocator_type>::construct(alloc, begin_ - 1, std::move(val));
         }
 
-        al_traits<allocator_type>::construct(alloc, begin_ - 1, std::forward<Args>(args)...);
+        offs.stats().on_construct(1);
         return begin_--;
     }
 
+    /**
+     * @brief Hands the buffer & its elements over to the caller, who then has to destroy them & deallocate it
+     * through get_allocator(), or give it to a devector again with the adopt_buffer constructor. The container is left empty.
+     * Blocks allocators serve from storage of their own, like small_buffer_allocator's arena, stay tied to the allocator.
+     */
+    raw_buffer release() noexcept{
+        const raw_buffer buffer{alloc.arr, offs.capacity, begin_, end_};
+        offs.stats().on_destroy(size());
+
+        alloc.arr = begin_ = end_ = nullptr;
+        offs.capacity = 0;
+
+        return buffer;
+    }
+
+    /**
+     * @brief Moves the elements out into a std::vector sharing the allocator, leaving the container empty & its memory freed.
+     * std::vector can't adopt a buffer, trivially copyable elements are copied over in bulk instead.
+     */
+    std::vector<value_type, allocator_type> to_vector() &&{
+        std::vector<value_type, allocator_type> vec(alloc.get());
+        vec.reserve(size());
+        vec.insert(vec.end(), std::make_move_iterator(begin_), std::make_move_iterator(end_));
+
+        destroy_all();
+        deallocate();
+        alloc.arr = begin_ = end_ = nullptr;
+
+        return vec;
+    }
+
     allocator_type get_allocator() const noexcept{
         return alloc;
     }
@@ -1236,61 +3078,72 @@ public:
     offset_by_type get_offset_by() const noexcept{
         return offs;
     }
-};
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator== (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
-    if(lhs.size() != rhs.size()){
-        return false;
+    growth_policy_type get_growth_policy() const noexcept{
+        return offs;
     }
 
-    for(auto it0 = lhs.begin(), it1 = rhs.begin(); it0 != lhs.end(); ++it0, ++it1){
-        if(*it0 != *it1){
-            return false;
-        }
+    stats_type& stats() noexcept{
+        return offs.stats();
     }
-    
-    return true;
+
+    const stats_type& stats() const noexcept{
+        return offs.stats();
+    }
+};
+
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator== (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
+    return lhs.size() == rhs.size() && simd::equal(lhs.cbegin(), rhs.cbegin(), lhs.size());
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator!= (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator!= (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
     return !(lhs == rhs);
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator< (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
-    auto it1 = rhs.cbegin();
-    for(auto it0 = lhs.cbegin(); it0 != lhs.cend(); ++it0, ++it1){
-        if(it1 == rhs.cend() || *it1 < *it0){
-            return false;
-        }else if(*it0 < *it1){
-            return true;
-        }
-    }
-
-    return it1 != rhs.cend();
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator< (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
+    return simd::less(lhs.cbegin(), lhs.size(), rhs.cbegin(), rhs.size());
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator<= (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator<= (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
     return !(rhs < lhs);
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator> (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator> (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
     return rhs < lhs;
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-bool operator>= (const devector<T, Alloc, OffsetByA>& lhs, const devector<T, Alloc, OffsetByB>& rhs){
+template<class T, class Alloc, class OffsetByA, class OffsetByB, class GrowthA, class GrowthB, class StatsA, class StatsB>
+bool operator>= (const devector<T, Alloc, OffsetByA, GrowthA, StatsA>& lhs, const devector<T, Alloc, OffsetByB, GrowthB, StatsB>& rhs){
     return !(lhs < rhs);
 }
 
-template<class T, class Alloc, class OffsetByA, class OffsetByB>
-void swap(devector<T, Alloc, OffsetByA>& x, devector<T, Alloc, OffsetByB> y){
+template<class T, class Alloc, class OffsetBy, class GrowthPolicy, class Stats>
+void swap(devector<T, Alloc, OffsetBy, GrowthPolicy, Stats>& x, devector<T, Alloc, OffsetBy, GrowthPolicy, Stats>& y){
     x.swap(y);
 }
 } //rdsl
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+namespace rdsl{
+namespace pmr{
+/**
+ * @brief A devector drawing its memory from a std::pmr::memory_resource. Like every polymorphic_allocator it isn't propagated
+ * on copy, move or swap, a devector keeps its resource for life and elements are moved one by one between different ones.
+ */
+template<class T, class OffsetBy = rdsl::offset_by, class GrowthPolicy = rdsl::geometric_growth<>, class Stats = rdsl::no_stats>
+using devector = rdsl::devector<T, std::pmr::polymorphic_allocator<T>, OffsetBy, GrowthPolicy, Stats>;
+} //pmr
+} //rdsl
+
+#endif
+#endif
+
 #endif
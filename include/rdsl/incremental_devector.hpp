@@ -0,0 +1,578 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * incremental_devector.hpp 0.0.0
+ *
+ * A header-only double ended vector growing incrementally, moving its elements to a bigger array a few at a time.
+ */
+
+#ifndef INCREMENTAL_DEVECTOR_RDSL_17102026
+#define INCREMENTAL_DEVECTOR_RDSL_17102026
+
+#include "devector.hpp"
+#include "ring_devector.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace rdsl{
+
+/**
+ * @brief A double ended vector whose pushes & pops take O(1) time in the worst case, not only amortized.
+ *
+ * Once an end runs out of room, a bigger array is allocated but the elements stay where they are. Every following
+ * push or pop migrates a few of them to the new array, like incremental rehashing does, just enough for all of them
+ * to be there before either end of it fills up. The old array is released as soon as it's empty. Until then, the
+ * elements aren't contiguous & accessing them costs an extra comparison, linearize() finishes the migration at once.
+ *
+ * The elements are centered in every new array, so the room is split evenly between both ends. An end filling up
+ * while most of the array is free, as in a queue, migrates to an array twice the size of the elements instead.
+ */
+template<typename T, class Alloc = std::allocator<T>, class GrowthPolicy = rdsl::geometric_growth<>>
+struct incremental_devector{
+    static_assert(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value,
+        "incremental_devector migrates elements in the middle of other operations, moving them can't throw");
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using growth_policy_type = GrowthPolicy;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename al_traits<allocator_type>::pointer;
+    using const_pointer = typename al_traits<allocator_type>::const_pointer;
+    using size_type = typename al_traits<allocator_type>::size_type;
+    using difference_type = typename al_traits<allocator_type>::difference_type;
+    using iterator = ring_iterator<incremental_devector, value_type>;
+    using const_iterator = ring_iterator<const incremental_devector, const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    struct compressed_alloc: public allocator_type{
+        compressed_alloc(const allocator_type& alloc = allocator_type())
+        :allocator_type(alloc)
+        {}
+
+        compressed_alloc(const compressed_alloc&) = delete;
+        compressed_alloc(compressed_alloc&&) noexcept = delete;
+        compressed_alloc& operator=(const compressed_alloc&) = delete;
+        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+
+        allocator_type& get() noexcept{ return *this; }
+        const allocator_type& get() const noexcept{ return *this; }
+
+        pointer arr;
+    }alloc;
+
+    struct compressed_growth: public growth_policy_type{
+        compressed_growth(const growth_policy_type& growth = growth_policy_type())
+        :growth_policy_type(growth)
+        {}
+
+        compressed_growth(const compressed_growth&) = delete;
+        compressed_growth(compressed_growth&&) noexcept = delete;
+        compressed_growth& operator=(const compressed_growth&) = delete;
+        compressed_growth& operator=(compressed_growth&&) noexcept = delete;
+
+        growth_policy_type& get() noexcept{ return *this; }
+        const growth_policy_type& get() const noexcept{ return *this; }
+
+        size_type capacity;
+    }growth;
+
+    size_type head_; // index of the first element inside the array
+    size_type size_;
+
+    // While migrating, the elements of slots [pending_first_, pending_last_) still live in the old array, from old_begin_ on.
+    pointer old_;
+    size_type old_capacity_;
+    pointer old_begin_;
+    size_type pending_first_;
+    size_type pending_last_;
+    size_type step_; // elements migrated by every push & pop
+
+    using relocation_tag = std::integral_constant<bool,
+        is_trivially_relocatable<value_type>::value && std::is_same<pointer, value_type*>::value
+    >;
+
+    pointer slot(size_type index) const noexcept{
+        const size_type s = head_ + index;
+        return s - pending_first_ < pending_last_ - pending_first_ ? old_begin_ + (s - pending_first_) : alloc.arr + s;
+    }
+
+    size_type next_capacity() const{
+        const size_type new_capacity = growth.get().next_capacity(growth.capacity, max_size());
+        if(new_capacity <= growth.capacity){
+            throw std::length_error("incremental_devector cannot grow past max_size()");
+        }
+        return new_capacity;
+    }
+
+    /**
+     * @brief The capacity to switch to once an end is full. When most of the array is free, as in a queue moving
+     * through it, the new array is sized by the elements instead of growing, so capacity stays bounded.
+     */
+    size_type capacity_for_room() const{
+        return size_ < growth.capacity / 2 ? 2 * size_ + 2 : next_capacity();
+    }
+
+    void migrate(pointer to, size_type n, std::true_type) noexcept{
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(old_begin_), n * sizeof(value_type));
+    }
+
+    void migrate(pointer to, size_type n, std::false_type) noexcept{
+        for(size_type i = 0; i < n; ++i){
+            al_traits<allocator_type>::construct(alloc, to + i, std::move(old_begin_[i]));
+            al_traits<allocator_type>::destroy(alloc, old_begin_ + i);
+        }
+    }
+
+    /**
+     * @brief Moves up to *n* pending elements to the new array, releasing the old one once nothing is left in it.
+     */
+    void migrate(size_type n) noexcept{
+        if(!old_capacity_){
+            return;
+        }
+
+        n = n < pending() ? n : pending();
+        if(n){
+            migrate(alloc.arr + pending_first_, n, relocation_tag());
+            old_begin_ += n;
+            pending_first_ += n;
+        }
+
+        if(pending_first_ == pending_last_){
+            alloc.deallocate(old_, old_capacity_);
+            old_ = old_begin_ = nullptr;
+            old_capacity_ = pending_first_ = pending_last_ = 0;
+        }
+    }
+
+    /**
+     * @brief Switches to a new array of *new_capacity* slots, the elements staying in the current one until migrated.
+     * Odd free slots go to the *front* or the back, whichever end needs room.
+     */
+    void grow(size_type new_capacity, bool front = false){
+        linearize();
+
+        const pointer arr = alloc.allocate(new_capacity);
+        const size_type new_head = (new_capacity - size_ + front) / 2;
+        if(size_){
+            old_ = alloc.arr;
+            old_capacity_ = growth.capacity;
+            old_begin_ = alloc.arr + head_;
+            pending_first_ = new_head;
+            pending_last_ = new_head + size_;
+
+            // Either end fills up after no less than *room* pushes, each of which migrates step_ elements.
+            const size_type room = new_head < new_capacity - pending_last_ ? new_head : new_capacity - pending_last_;
+            step_ = room ? (size_ + room - 1) / room : size_;
+        }else{
+            deallocate();
+        }
+
+        alloc.arr = arr;
+        growth.capacity = new_capacity;
+        head_ = new_head;
+    }
+
+    void destroy_all() noexcept{
+        for(size_type i = 0; i < size_; ++i){
+            al_traits<allocator_type>::destroy(alloc, slot(i));
+        }
+        size_ = 0;
+        head_ = growth.capacity / 2;
+
+        if(old_capacity_){
+            pending_first_ = pending_last_;
+            migrate(0);
+        }
+    }
+
+    void deallocate() noexcept{
+        if(growth.capacity){
+            alloc.deallocate(alloc.arr, growth.capacity);
+            growth.capacity = 0;
+        }
+        alloc.arr = nullptr;
+    }
+
+    void steal_ownership(incremental_devector& x) noexcept{
+        alloc.arr = x.alloc.arr;
+        growth.capacity = x.growth.capacity;
+        head_ = x.head_;
+        size_ = x.size_;
+        old_ = x.old_;
+        old_capacity_ = x.old_capacity_;
+        old_begin_ = x.old_begin_;
+        pending_first_ = x.pending_first_;
+        pending_last_ = x.pending_last_;
+        step_ = x.step_;
+
+        x.alloc.arr = x.old_ = x.old_begin_ = nullptr;
+        x.growth.capacity = x.head_ = x.size_ = x.old_capacity_ = x.pending_first_ = x.pending_last_ = 0;
+    }
+
+    // Allocators are only assigned or swapped when their propagate_on_container_* trait says so,
+    // some of them, like std::pmr::polymorphic_allocator, can't be assigned at all.
+    template<class Allocator>
+    void propagate_allocator(Allocator&& allocator, std::true_type){
+        alloc.get() = std::forward<Allocator>(allocator);
+    }
+
+    template<class Allocator>
+    void propagate_allocator(Allocator&&, std::false_type) noexcept{}
+
+    void swap_allocator(incremental_devector& x, std::true_type){
+        using std::swap;
+        swap(alloc.get(), x.alloc.get());
+    }
+
+    void swap_allocator(incremental_devector&, std::false_type) noexcept{}
+
+    /**
+     * @brief Replaces the elements with copies of *x*'s, in an array of this container's allocator.
+     */
+    void assign_copy(const incremental_devector& x){
+        destroy_all();
+        if(growth.capacity < x.size_){
+            deallocate();
+            alloc.arr = alloc.allocate(x.size_);
+            growth.capacity = x.size_;
+        }
+
+        head_ = (growth.capacity - x.size_) / 2;
+        for(const_reference val: x){
+            al_traits<allocator_type>::construct(alloc, alloc.arr + head_ + size_, val);
+            ++size_;
+        }
+    }
+
+public:
+
+    explicit incremental_devector(const allocator_type& allocator = allocator_type(), const growth_policy_type& growth_policy = growth_policy_type())
+    :alloc(allocator), growth(growth_policy), head_(0), size_(0),
+    old_(nullptr), old_capacity_(0), old_begin_(nullptr), pending_first_(0), pending_last_(0), step_(0)
+    {
+        alloc.arr = nullptr;
+        growth.capacity = 0;
+    }
+
+    incremental_devector(const incremental_devector& x)
+    :incremental_devector(al_traits<allocator_type>::select_on_container_copy_construction(x.alloc), x.growth)
+    {
+        if(x.size_){
+            alloc.arr = alloc.allocate(x.size_);
+            growth.capacity = x.size_;
+            for(const_reference val: x){
+                al_traits<allocator_type>::construct(alloc, alloc.arr + size_, val);
+                ++size_;
+            }
+        }
+    }
+
+    incremental_devector(incremental_devector&& x) noexcept
+    :incremental_devector(x.alloc, x.growth)
+    {
+        steal_ownership(x);
+    }
+
+    incremental_devector(std::initializer_list<value_type> il, const allocator_type& allocator = allocator_type())
+    :incremental_devector(allocator)
+    {
+        reserve(il.size());
+        head_ = 0;
+        for(const_reference val: il){
+            push_back(val);
+        }
+    }
+
+    ~incremental_devector(){
+        destroy_all();
+        deallocate();
+    }
+
+    incremental_devector& operator=(const incremental_devector& x){
+        if(this == &x){
+            return *this;
+        }
+
+        growth.get() = x.growth.get();
+
+        using propagate = typename al_traits<allocator_type>::propagate_on_container_copy_assignment;
+        if(propagate::value && alloc.get() != x.alloc.get()){
+            // The current array goes back to the allocator that allocated it before that one is replaced.
+            destroy_all();
+            deallocate();
+            propagate_allocator(x.alloc.get(), propagate());
+        }
+        assign_copy(x);
+
+        return *this;
+    }
+
+    incremental_devector& operator=(incremental_devector&& x){
+        if(this == &x){
+            return *this;
+        }
+
+        growth.get() = std::move(x.growth.get());
+
+        using propagate = typename al_traits<allocator_type>::propagate_on_container_move_assignment;
+        if(propagate::value || alloc.get() == x.alloc.get()){
+            destroy_all();
+            deallocate();
+            propagate_allocator(std::move(x.alloc.get()), propagate());
+            steal_ownership(x);
+        }else{
+            // Memory can't change hands, move the elements one by one instead.
+            destroy_all();
+            for(reference val: x){
+                push_back(std::move(val));
+            }
+            x.clear();
+        }
+
+        return *this;
+    }
+
+    size_type size() const noexcept{
+        return size_;
+    }
+
+    size_type capacity() const noexcept{
+        return growth.capacity;
+    }
+
+    size_type max_size() const{
+        return al_traits<allocator_type>::max_size(alloc);
+    }
+
+    bool empty() const noexcept{
+        return !size_;
+    }
+
+    /**
+     * @brief How many elements still live in the previous array, 0 once the migration completed.
+     */
+    size_type pending() const noexcept{
+        return pending_last_ - pending_first_;
+    }
+
+    bool migrating() const noexcept{
+        return old_capacity_ != 0;
+    }
+
+    iterator begin() noexcept{ return iterator(this, 0); }
+    const_iterator begin() const noexcept{ return const_iterator(this, 0); }
+    iterator end() noexcept{ return iterator(this, size_); }
+    const_iterator end() const noexcept{ return const_iterator(this, size_); }
+    reverse_iterator rbegin() noexcept{ return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept{ return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept{ return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept{ return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept{ return begin(); }
+    const_iterator cend() const noexcept{ return end(); }
+    const_reverse_iterator crbegin() const noexcept{ return rbegin(); }
+    const_reverse_iterator crend() const noexcept{ return rend(); }
+
+    reference operator[](size_type index){
+        return *slot(index);
+    }
+
+    const_reference operator[](size_type index) const{
+        return *slot(index);
+    }
+
+    reference at(size_type index){
+        if(index < size_){
+            return *slot(index);
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for array of size " + std::to_string(size()));
+        }
+    }
+
+    const_reference at(size_type index) const{
+        if(index < size_){
+            return *slot(index);
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for array of size " + std::to_string(size()));
+        }
+    }
+
+    reference front(){ return *slot(0); }
+    const_reference front() const{ return *slot(0); }
+    reference back(){ return *slot(size_ - 1); }
+    const_reference back() const{ return *slot(size_ - 1); }
+
+    /**
+     * @brief Finishes migrating, making the elements contiguous.
+     *
+     * @return pointer to the first element.
+     */
+    pointer linearize() noexcept{
+        migrate(pending());
+        return alloc.arr + head_;
+    }
+
+    /**
+     * @brief Copies the elements into a devector.
+     */
+    template<class OffsetBy = rdsl::offset_by>
+    devector<value_type, allocator_type, OffsetBy, growth_policy_type> to_devector(const OffsetBy& offset_by = OffsetBy()) const{
+        return devector<value_type, allocator_type, OffsetBy, growth_policy_type>(begin(), end(), size_, alloc, offset_by);
+    }
+
+    /**
+     * @brief Grows to at least *n* slots, like any growth migrating the elements incrementally & splitting the room between both ends.
+     */
+    void reserve(size_type n){
+        if(n > growth.capacity){
+            grow(n);
+        }
+    }
+
+    void push_back(const_reference val){
+        emplace_back(val);
+    }
+
+    void push_back(value_type&& val){
+        emplace_back(std::move(val));
+    }
+
+    void push_front(const_reference val){
+        emplace_front(val);
+    }
+
+    void push_front(value_type&& val){
+        emplace_front(std::move(val));
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args){
+        if(head_ + size_ == growth.capacity){
+            grow(capacity_for_room());
+        }
+
+        const pointer p = alloc.arr + head_ + size_;
+        al_traits<allocator_type>::construct(alloc, p, std::forward<Args>(args)...);
+        ++size_;
+        migrate(step_);
+        return *p;
+    }
+
+    template<class... Args>
+    reference emplace_front(Args&&... args){
+        if(!head_){
+            grow(capacity_for_room(), true);
+        }
+
+        const pointer p = alloc.arr + head_ - 1;
+        al_traits<allocator_type>::construct(alloc, p, std::forward<Args>(args)...);
+        --head_;
+        ++size_;
+        migrate(step_);
+        return *p;
+    }
+
+    void pop_back() noexcept{
+        al_traits<allocator_type>::destroy(alloc, slot(size_ - 1));
+        if(pending() && head_ + size_ == pending_last_){
+            --pending_last_;
+        }
+        --size_;
+        migrate(step_);
+    }
+
+    void pop_front() noexcept{
+        al_traits<allocator_type>::destroy(alloc, slot(0));
+        if(pending() && head_ == pending_first_){
+            ++old_begin_;
+            ++pending_first_;
+        }
+        ++head_;
+        --size_;
+        migrate(step_);
+    }
+
+    void clear() noexcept{
+        destroy_all();
+    }
+
+    /**
+     * @brief Exchanges the elements & growth policies of both containers. Allocators are exchanged only if
+     * propagate_on_container_swap holds, otherwise elements are moved one by one when they compare unequal.
+     */
+    void swap(incremental_devector& x){
+        // Arrays can't change hands between allocators that stay put & compare unequal.
+        if(!al_traits<allocator_type>::propagate_on_container_swap::value && alloc.get() != x.alloc.get()){
+            incremental_devector temp(std::move(x));
+            x = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
+
+        std::swap(alloc.arr, x.alloc.arr);
+        std::swap(growth.capacity, x.growth.capacity);
+        std::swap(head_, x.head_);
+        std::swap(size_, x.size_);
+        std::swap(old_, x.old_);
+        std::swap(old_capacity_, x.old_capacity_);
+        std::swap(old_begin_, x.old_begin_);
+        std::swap(pending_first_, x.pending_first_);
+        std::swap(pending_last_, x.pending_last_);
+        std::swap(step_, x.step_);
+        std::swap(growth.get(), x.growth.get());
+        swap_allocator(x, typename al_traits<allocator_type>::propagate_on_container_swap());
+    }
+
+    allocator_type get_allocator() const noexcept{
+        return alloc;
+    }
+
+    growth_policy_type get_growth_policy() const noexcept{
+        return growth;
+    }
+};
+
+template<class T, class Alloc, class GrowthPolicy>
+bool operator== (const incremental_devector<T, Alloc, GrowthPolicy>& lhs, const incremental_devector<T, Alloc, GrowthPolicy>& rhs){
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<class T, class Alloc, class GrowthPolicy>
+bool operator!= (const incremental_devector<T, Alloc, GrowthPolicy>& lhs, const incremental_devector<T, Alloc, GrowthPolicy>& rhs){
+    return !(lhs == rhs);
+}
+
+template<class T, class Alloc, class GrowthPolicy>
+void swap(incremental_devector<T, Alloc, GrowthPolicy>& x, incremental_devector<T, Alloc, GrowthPolicy>& y){
+    x.swap(y);
+}
+} //rdsl
+
+#endif
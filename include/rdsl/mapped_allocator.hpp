@@ -0,0 +1,332 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * mapped_allocator.hpp 0.0.0
+ *
+ * A header-only file backed allocator, letting devectors outlive the process & grow past RAM. POSIX only.
+ */
+
+#ifndef MAPPED_ALLOCATOR_RDSL_17102026
+#define MAPPED_ALLOCATOR_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+namespace rdsl{
+
+/**
+ * @brief The first page of a mapped file, describing the devector stored after it as of the last sync().
+ */
+struct mapped_header{
+    char magic[8];
+    std::uint64_t element_size;
+    std::uint64_t capacity;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+/**
+ * @brief A file and the parts of it currently mapped, shared by all copies of a mapped_allocator.
+ */
+struct mapped_file{
+    static const char* magic() noexcept{
+        return "rdslmap";
+    }
+
+    mapped_file(const std::string& path, size_t element_size)
+    :fd(::open(path.c_str(), O_RDWR | O_CREAT, 0644)), page(static_cast<size_t>(::sysconf(_SC_PAGESIZE))), data(nullptr), bytes(0)
+    {
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+        }
+
+        struct stat st;
+        const bool fresh = !::fstat(fd, &st) && static_cast<size_t>(st.st_size) < page;
+        if(fresh && ::ftruncate(fd, page)){
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "cannot resize " + path);
+        }
+
+        void* const h = ::mmap(nullptr, page, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(h == MAP_FAILED){
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "cannot map " + path);
+        }
+        header = static_cast<mapped_header*>(h);
+
+        if(fresh){
+            std::memset(header, 0, sizeof(mapped_header));
+            std::memcpy(header->magic, magic(), sizeof(header->magic));
+            header->element_size = element_size;
+        }else if(std::memcmp(header->magic, magic(), sizeof(header->magic)) || header->element_size != element_size){
+            ::munmap(header, page);
+            ::close(fd);
+            throw std::runtime_error(path + " doesn't hold elements of this type");
+        }
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file(){
+        if(data){
+            ::munmap(data, bytes);
+        }
+        ::munmap(header, page);
+        ::close(fd);
+    }
+
+    // The elements start right after the header page, so their offset in the file stays page aligned.
+    void* map(size_t length){
+        void* const p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(page));
+        if(p == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void resize(size_t length){
+        if(::ftruncate(fd, static_cast<off_t>(page + length))){
+            throw std::bad_alloc();
+        }
+    }
+
+    int fd;
+    size_t page;
+    mapped_header* header;
+    void* data;     // the file backed block while it's allocated, nullptr otherwise
+    size_t bytes;   // its length
+};
+
+/**
+ * @brief Hands out a single block backed by a file, growing it with ftruncate & mremap.
+ *
+ * Pages are faulted in lazily and written back by the kernel, so the block may be larger than RAM.
+ * Whatever is allocated while the file backed block is taken, e.g. by a copy of a devector, and
+ * everything a default constructed mapped_allocator allocates, comes from anonymous memory instead.
+ *
+ * Records are stored as raw bytes, so T has to be trivially copyable. Use sync() & open_mapped()
+ * to keep a devector across runs.
+ */
+template<class T>
+struct mapped_allocator{
+    static_assert(std::is_trivially_copyable<T>::value, "mapped_allocator elements must be trivially copyable");
+
+    using value_type = T;
+    using pointer = T*;
+    using size_type = size_t;
+
+    mapped_allocator() noexcept = default;
+
+    /**
+     * @brief Opens *path*, creating it if it doesn't exist.
+     * Throws std::runtime_error if it holds anything but elements of T's size.
+     */
+    explicit mapped_allocator(const std::string& path)
+    :file(std::make_shared<mapped_file>(path, sizeof(T)))
+    {}
+
+    template<class U>
+    mapped_allocator(const mapped_allocator<U>& x) noexcept
+    :file(x.file) {}
+
+    pointer allocate(size_type n){
+        if(!n){
+            return nullptr;
+        }
+
+        const size_t bytes = n * sizeof(T);
+        if(!file || file->data){
+            void* const p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(p == MAP_FAILED){
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(p);
+        }
+
+        file->resize(bytes);
+        file->data = file->map(bytes);
+        file->bytes = bytes;
+        described(n);
+        return static_cast<pointer>(file->data);
+    }
+
+    void deallocate(pointer p, size_type n) noexcept{
+        if(!p){
+            return;
+        }
+
+        if(file && p == file->data){
+            // The contents stay in the file.
+            ::munmap(file->data, file->bytes);
+            file->data = nullptr;
+        }else{
+            ::munmap(p, n * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Resizes a block in place like realloc, keeping its first min(old_n, new_n) elements.
+     * On failure the block is left untouched.
+     */
+    pointer reallocate(pointer p, size_type old_n, size_type new_n){
+        if(!p){
+            return allocate(new_n);
+        }else if(!new_n){
+            deallocate(p, old_n);
+            if(file && !file->data){
+                described(0);
+            }
+            return nullptr;
+        }
+
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = new_n * sizeof(T);
+
+        if(!file || p != file->data){
+            const pointer q = mapped_allocator().allocate(new_n);
+            std::memcpy(q, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+            ::munmap(p, old_bytes);
+            return q;
+        }
+
+        if(new_bytes > old_bytes){
+            file->resize(new_bytes);
+        }
+
+#if defined(__linux__)
+        void* const q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if(q == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+#else
+        // Both mappings show the same file, so nothing needs copying.
+        void* const q = file->map(new_bytes);
+        ::munmap(p, old_bytes);
+#endif
+
+        if(new_bytes < old_bytes){
+            file->resize(new_bytes);
+        }
+
+        file->data = q;
+        file->bytes = new_bytes;
+        described(new_n);
+        return static_cast<pointer>(q);
+    }
+
+    /**
+     * @brief Records that *size* elements starting *offset* slots into the file backed block are live & flushes it all to disk.
+     */
+    void sync(size_type offset, size_type size){
+        file->header->offset = offset;
+        file->header->size = size;
+        if(file->data && ::msync(file->data, file->bytes, MS_SYNC)){
+            throw std::system_error(errno, std::generic_category(), "cannot sync");
+        }
+        if(::msync(file->header, file->page, MS_SYNC)){
+            throw std::system_error(errno, std::generic_category(), "cannot sync");
+        }
+    }
+
+    /**
+     * @brief Maps the block a previous run left in the file, without reading any of it.
+     */
+    pointer attach(){
+        const size_t bytes = file->header->capacity * sizeof(T);
+        if(!bytes){
+            return nullptr;
+        }
+
+        file->data = file->map(bytes);
+        file->bytes = bytes;
+        return static_cast<pointer>(file->data);
+    }
+
+    const mapped_header& header() const noexcept{
+        return *file->header;
+    }
+
+    template<class U>
+    bool operator==(const mapped_allocator<U>& x) const noexcept{ return file == x.file; }
+
+    template<class U>
+    bool operator!=(const mapped_allocator<U>& x) const noexcept{ return file != x.file; }
+
+    std::shared_ptr<mapped_file> file;
+
+private:
+    // Whatever the header described doesn't exist anymore, until the next sync().
+    void described(size_type capacity) noexcept{
+        file->header->capacity = capacity;
+        file->header->offset = 0;
+        file->header->size = 0;
+    }
+};
+
+template<class T, class OffsetBy = rdsl::offset_by, class GrowthPolicy = rdsl::geometric_growth<>, class Stats = rdsl::no_stats>
+using mapped_devector = devector<T, mapped_allocator<T>, OffsetBy, GrowthPolicy, Stats>;
+
+/**
+ * @brief Flushes *vec* to its file, recording where its elements lie so open_mapped() can find them.
+ */
+template<class T, class OffsetBy, class GrowthPolicy, class Stats>
+void sync(mapped_devector<T, OffsetBy, GrowthPolicy, Stats>& vec){
+    vec.get_allocator().sync(vec.begin() - vec.data(), vec.size());
+}
+
+/**
+ * @brief Reopens the devector last synced to *path*, or an empty one if there's none. O(1), the elements aren't touched.
+ */
+template<class T, class OffsetBy = rdsl::offset_by, class GrowthPolicy = rdsl::geometric_growth<>, class Stats = rdsl::no_stats>
+mapped_devector<T, OffsetBy, GrowthPolicy, Stats> open_mapped(const std::string& path, const OffsetBy& offset_by = OffsetBy()){
+    mapped_allocator<T> alloc(path);
+    const mapped_header header = alloc.header();
+    T* const arr = alloc.attach();
+
+    return mapped_devector<T, OffsetBy, GrowthPolicy, Stats>(
+        adopt_buffer, arr, header.capacity, header.offset, header.size, alloc, offset_by
+    );
+}
+} //rdsl
+
+#endif
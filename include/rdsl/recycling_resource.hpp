@@ -0,0 +1,183 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * recycling_resource.hpp 0.0.0
+ *
+ * A header-only C++17 memory resource keeping freed blocks in per size class free lists, so short-lived devectors reuse each other's buffers.
+ */
+
+#ifndef RECYCLING_RESOURCE_RDSL_17102026
+#define RECYCLING_RESOURCE_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
+
+namespace rdsl{
+namespace pmr{
+
+/**
+ * @brief Rounds requests up to a power of two size class & keeps the blocks freed in each class for the next
+ * allocation of the same class, falling back to an upstream resource for everything else.
+ *
+ * Free lists aren't synchronized, the thread that created the resource is the only one recycling blocks.
+ * Other threads may still allocate & deallocate through it, they go straight to upstream. At most
+ * *max_cached* blocks are kept per class, requests over max_block bytes or over-aligned ones aren't recycled.
+ */
+class recycling_resource: public std::pmr::memory_resource{
+public:
+    static constexpr std::size_t min_block = 16;
+    static constexpr std::size_t size_classes = 24;
+    static constexpr std::size_t max_block = min_block << (size_classes - 1);
+
+    explicit recycling_resource(
+        std::size_t max_cached = 64,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource()
+    ) noexcept
+    :upstream_(upstream), max_cached_(max_cached), owner_(std::this_thread::get_id())
+    {}
+
+    recycling_resource(const recycling_resource&) = delete;
+    recycling_resource& operator=(const recycling_resource&) = delete;
+
+    ~recycling_resource(){
+        release();
+    }
+
+    /**
+     * @brief Hands every cached block back to upstream. Blocks in use are unaffected.
+     */
+    void release() noexcept{
+        for(std::size_t i = 0; i < size_classes; ++i){
+            while(free_[i].head){
+                block* const b = free_[i].head;
+                free_[i].head = b->next;
+                upstream_->deallocate(b, class_size(i), alignof(std::max_align_t));
+            }
+            free_[i].count = 0;
+        }
+    }
+
+    std::size_t cached_blocks() const noexcept{
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < size_classes; ++i){
+            n += free_[i].count;
+        }
+        return n;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept{
+        return upstream_;
+    }
+
+    static constexpr std::size_t class_size(std::size_t size_class) noexcept{
+        return min_block << size_class;
+    }
+
+    static std::size_t size_class(std::size_t bytes) noexcept{
+        std::size_t c = 0;
+        while(class_size(c) < bytes){
+            ++c;
+        }
+        return c;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override{
+        if(!recyclable(bytes, alignment)){
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        const std::size_t c = size_class(bytes);
+        if(free_[c].head && owned()){
+            block* const b = free_[c].head;
+            free_[c].head = b->next;
+            --free_[c].count;
+            return b;
+        }
+
+        // Blocks are always as big as their class, whichever thread allocates them, so any of them can be recycled.
+        return upstream_->allocate(class_size(c), alignof(std::max_align_t));
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override{
+        if(!recyclable(bytes, alignment)){
+            upstream_->deallocate(p, bytes, alignment);
+            return;
+        }
+
+        const std::size_t c = size_class(bytes);
+        if(free_[c].count < max_cached_ && owned()){
+            free_[c].head = ::new(p) block{free_[c].head};
+            ++free_[c].count;
+        }else{
+            upstream_->deallocate(p, class_size(c), alignof(std::max_align_t));
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+        return this == &other;
+    }
+
+private:
+    struct block{
+        block* next;
+    };
+
+    struct free_list{
+        block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static bool recyclable(std::size_t bytes, std::size_t alignment) noexcept{
+        return bytes <= max_block && alignment <= alignof(std::max_align_t);
+    }
+
+    bool owned() const noexcept{
+        return std::this_thread::get_id() == owner_;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t max_cached_;
+    std::thread::id owner_;
+    free_list free_[size_classes];
+};
+
+/**
+ * @brief The calling thread's own recycling_resource, destroyed when the thread exits.
+ * Devectors using it shouldn't outlive the thread.
+ */
+inline recycling_resource& thread_recycling_resource() noexcept{
+    thread_local recycling_resource resource;
+    return resource;
+}
+
+} //pmr
+} //rdsl
+
+#endif
@@ -0,0 +1,567 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * ring_devector.hpp 0.0.0
+ *
+ * A header-only double ended ring buffer, wrapping around its storage instead of shifting or reallocating.
+ */
+
+#ifndef RING_DEVECTOR_RDSL_17102026
+#define RING_DEVECTOR_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <utility>
+#include <cstddef>
+
+namespace rdsl{
+
+template<class Ring, class Value>
+struct ring_iterator{
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename std::remove_const<Value>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    ring_iterator(Ring* ring = nullptr, size_t index = 0) noexcept
+    :ring(ring), index(index) {}
+
+    // iterator to const_iterator
+    template<class OtherRing, class OtherValue, enable_if_t<std::is_convertible<OtherValue*, Value*>::value, int> = 0>
+    ring_iterator(const ring_iterator<OtherRing, OtherValue>& other) noexcept
+    :ring(other.ring), index(other.index) {}
+
+    reference operator*() const{ return (*ring)[index]; }
+    pointer operator->() const{ return &(*ring)[index]; }
+    reference operator[](difference_type n) const{ return (*ring)[index + n]; }
+
+    ring_iterator& operator++() noexcept{ ++index; return *this; }
+    ring_iterator& operator--() noexcept{ --index; return *this; }
+    ring_iterator operator++(int) noexcept{ return ring_iterator(ring, index++); }
+    ring_iterator operator--(int) noexcept{ return ring_iterator(ring, index--); }
+
+    ring_iterator& operator+=(difference_type n) noexcept{ index += n; return *this; }
+    ring_iterator& operator-=(difference_type n) noexcept{ index -= n; return *this; }
+    ring_iterator operator+(difference_type n) const noexcept{ return ring_iterator(ring, index + n); }
+    ring_iterator operator-(difference_type n) const noexcept{ return ring_iterator(ring, index - n); }
+    friend ring_iterator operator+(difference_type n, const ring_iterator& it) noexcept{ return it + n; }
+
+    difference_type operator-(const ring_iterator& other) const noexcept{
+        return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+    }
+
+    bool operator==(const ring_iterator& other) const noexcept{ return index == other.index; }
+    bool operator!=(const ring_iterator& other) const noexcept{ return index != other.index; }
+    bool operator<(const ring_iterator& other) const noexcept{ return index < other.index; }
+    bool operator>(const ring_iterator& other) const noexcept{ return index > other.index; }
+    bool operator<=(const ring_iterator& other) const noexcept{ return index <= other.index; }
+    bool operator>=(const ring_iterator& other) const noexcept{ return index >= other.index; }
+
+    Ring* ring;
+    size_t index;
+};
+
+/**
+ * @brief A double ended ring buffer. Pushing and popping at either end is O(1) and never moves
+ * elements as long as there is spare capacity, since the storage wraps around instead.
+ *
+ * Once full, pushing reallocates according to GrowthPolicy like devector does, check full()
+ * beforehand to use it as a bounded queue.
+ */
+template<typename T, class Alloc = std::allocator<T>, class GrowthPolicy = rdsl::geometric_growth<>>
+struct ring_devector{
+    using value_type = T;
+    using allocator_type = Alloc;
+    using growth_policy_type = GrowthPolicy;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename al_traits<allocator_type>::pointer;
+    using const_pointer = typename al_traits<allocator_type>::const_pointer;
+    using size_type = typename al_traits<allocator_type>::size_type;
+    using difference_type = typename al_traits<allocator_type>::difference_type;
+    using iterator = ring_iterator<ring_devector, value_type>;
+    using const_iterator = ring_iterator<const ring_devector, const value_type>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using segment = std::pair<pointer, size_type>;
+    using const_segment = std::pair<const_pointer, size_type>;
+
+private:
+    struct compressed_alloc: public allocator_type{
+        compressed_alloc(const allocator_type& alloc = allocator_type())
+        :allocator_type(alloc)
+        {}
+
+        compressed_alloc(const compressed_alloc&) = delete;
+        compressed_alloc(compressed_alloc&&) noexcept = delete;
+        compressed_alloc& operator=(const compressed_alloc&) = delete;
+        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+
+        allocator_type& get() noexcept{ return *this; }
+        const allocator_type& get() const noexcept{ return *this; }
+
+        pointer arr;
+    }alloc;
+
+    struct compressed_growth: public growth_policy_type{
+        compressed_growth(const growth_policy_type& growth = growth_policy_type())
+        :growth_policy_type(growth)
+        {}
+
+        compressed_growth(const compressed_growth&) = delete;
+        compressed_growth(compressed_growth&&) noexcept = delete;
+        compressed_growth& operator=(const compressed_growth&) = delete;
+        compressed_growth& operator=(compressed_growth&&) noexcept = delete;
+
+        growth_policy_type& get() noexcept{ return *this; }
+        const growth_policy_type& get() const noexcept{ return *this; }
+
+        size_type capacity;
+    }growth;
+
+    size_type head_; // index of the first element inside the array
+    size_type size_;
+
+    using relocation_tag = std::integral_constant<bool,
+        is_trivially_relocatable<value_type>::value && std::is_same<pointer, value_type*>::value
+    >;
+
+    /**
+     * @brief Maps an index in [0, 2 * capacity) back into the array.
+     */
+    size_type wrap(size_type index) const noexcept{
+        return index < growth.capacity ? index : index - growth.capacity;
+    }
+
+    pointer slot(size_type index) const noexcept{
+        return alloc.arr + wrap(head_ + index);
+    }
+
+    size_type next_capacity() const{
+        const size_type new_capacity = growth.get().next_capacity(growth.capacity, max_size());
+        if(new_capacity <= growth.capacity){
+            throw std::length_error("ring_devector cannot grow past max_size()");
+        }
+        return new_capacity;
+    }
+
+    void destroy_all() noexcept{
+        while(size_){
+            pop_back();
+        }
+        head_ = 0;
+    }
+
+    void deallocate() noexcept{
+        if(growth.capacity){
+            alloc.deallocate(alloc.arr, growth.capacity);
+            growth.capacity = 0;
+        }
+        alloc.arr = nullptr;
+    }
+
+    void steal_ownership(ring_devector& x) noexcept{
+        alloc.arr = x.alloc.arr;
+        growth.capacity = x.growth.capacity;
+        head_ = x.head_;
+        size_ = x.size_;
+
+        x.alloc.arr = nullptr;
+        x.growth.capacity = x.head_ = x.size_ = 0;
+    }
+
+    // Allocators are only assigned or swapped when their propagate_on_container_* trait says so,
+    // some of them, like std::pmr::polymorphic_allocator, can't be assigned at all.
+    template<class Allocator>
+    void propagate_allocator(Allocator&& allocator, std::true_type){
+        alloc.get() = std::forward<Allocator>(allocator);
+    }
+
+    template<class Allocator>
+    void propagate_allocator(Allocator&&, std::false_type) noexcept{}
+
+    void swap_allocator(ring_devector& x, std::true_type){
+        using std::swap;
+        swap(alloc.get(), x.alloc.get());
+    }
+
+    void swap_allocator(ring_devector&, std::false_type) noexcept{}
+
+    /**
+     * @brief Moves the elements, in order, to the start of a new array of *new_capacity* slots.
+     */
+    void reallocate(size_type new_capacity){
+        // Nothing is allocated for no elements, a capacity of 0 is never deallocated.
+        if(!new_capacity){
+            deallocate();
+            head_ = 0;
+            return;
+        }
+
+        const size_type count = size_;
+        const pointer arr = alloc.allocate(new_capacity);
+        try{
+            reallocate(arr, relocation_tag());
+        }catch(...){
+            alloc.deallocate(arr, new_capacity);
+            throw;
+        }
+
+        destroy_all();
+        deallocate();
+
+        alloc.arr = arr;
+        growth.capacity = new_capacity;
+        size_ = count;
+    }
+
+    void reallocate(pointer arr, std::true_type) noexcept{
+        const segment one = first_segment();
+        const segment two = second_segment();
+
+        if(one.second){
+            std::memcpy(static_cast<void*>(arr), static_cast<const void*>(one.first), one.second * sizeof(value_type));
+        }
+        if(two.second){
+            std::memcpy(static_cast<void*>(arr + one.second), static_cast<const void*>(two.first), two.second * sizeof(value_type));
+        }
+
+        // The bytes now belong to the new array, nothing is left to destroy.
+        size_ = 0;
+    }
+
+    void reallocate(pointer arr, std::false_type){
+        size_type constructed = 0;
+        try{
+            for(; constructed < size_; ++constructed){
+                al_traits<allocator_type>::construct(alloc, arr + constructed, std::move_if_noexcept(*slot(constructed)));
+            }
+        }catch(...){
+            while(constructed){
+                al_traits<allocator_type>::destroy(alloc, arr + --constructed);
+            }
+            throw;
+        }
+    }
+
+    void make_room(){
+        if(full()){
+            reallocate(next_capacity());
+        }
+    }
+
+public:
+
+    explicit ring_devector(const allocator_type& allocator = allocator_type(), const growth_policy_type& growth_policy = growth_policy_type())
+    :alloc(allocator), growth(growth_policy), head_(0), size_(0)
+    {
+        alloc.arr = nullptr;
+        growth.capacity = 0;
+    }
+
+    explicit ring_devector(
+        size_type capacity,
+        const allocator_type& allocator = allocator_type(),
+        const growth_policy_type& growth_policy = growth_policy_type()
+    )
+    :ring_devector(allocator, growth_policy)
+    {
+        reserve(capacity);
+    }
+
+    ring_devector(const ring_devector& x)
+    :ring_devector(al_traits<allocator_type>::select_on_container_copy_construction(x.alloc), x.growth)
+    {
+        reserve(x.size_);
+        for(const_reference val: x){
+            push_back(val);
+        }
+    }
+
+    ring_devector(ring_devector&& x) noexcept
+    :ring_devector(x.alloc, x.growth)
+    {
+        steal_ownership(x);
+    }
+
+    ~ring_devector(){
+        destroy_all();
+        deallocate();
+    }
+
+    ring_devector& operator=(const ring_devector& x){
+        if(this == &x){
+            return *this;
+        }
+
+        growth.get() = x.growth.get();
+
+        using propagate = typename al_traits<allocator_type>::propagate_on_container_copy_assignment;
+        if(propagate::value && alloc.get() != x.alloc.get()){
+            // The current array goes back to the allocator that allocated it before that one is replaced.
+            destroy_all();
+            deallocate();
+            propagate_allocator(x.alloc.get(), propagate());
+        }
+
+        // Copied one by one into an array of this ring's allocator.
+        destroy_all();
+        reserve(x.size_);
+        for(const_reference val: x){
+            push_back(val);
+        }
+
+        return *this;
+    }
+
+    ring_devector& operator=(ring_devector&& x){
+        if(this == &x){
+            return *this;
+        }
+
+        growth.get() = std::move(x.growth.get());
+
+        using propagate = typename al_traits<allocator_type>::propagate_on_container_move_assignment;
+        if(propagate::value || alloc.get() == x.alloc.get()){
+            destroy_all();
+            deallocate();
+            propagate_allocator(std::move(x.alloc.get()), propagate());
+            steal_ownership(x);
+        }else{
+            // Memory can't change hands, move the elements one by one instead.
+            destroy_all();
+            reserve(x.size_);
+            for(reference val: x){
+                push_back(std::move(val));
+            }
+            x.clear();
+        }
+
+        return *this;
+    }
+
+    size_type size() const noexcept{
+        return size_;
+    }
+
+    size_type capacity() const noexcept{
+        return growth.capacity;
+    }
+
+    size_type max_size() const{
+        return al_traits<allocator_type>::max_size(alloc);
+    }
+
+    bool empty() const noexcept{
+        return !size_;
+    }
+
+    bool full() const noexcept{
+        return size_ == growth.capacity;
+    }
+
+    iterator begin() noexcept{ return iterator(this, 0); }
+    const_iterator begin() const noexcept{ return const_iterator(this, 0); }
+    iterator end() noexcept{ return iterator(this, size_); }
+    const_iterator end() const noexcept{ return const_iterator(this, size_); }
+    reverse_iterator rbegin() noexcept{ return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept{ return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept{ return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept{ return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept{ return begin(); }
+    const_iterator cend() const noexcept{ return end(); }
+    const_reverse_iterator crbegin() const noexcept{ return rbegin(); }
+    const_reverse_iterator crend() const noexcept{ return rend(); }
+
+    reference operator[](size_type index){
+        return *slot(index);
+    }
+
+    const_reference operator[](size_type index) const{
+        return *slot(index);
+    }
+
+    reference at(size_type index){
+        if(index < size_){
+            return *slot(index);
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for ring of size " + std::to_string(size()));
+        }
+    }
+
+    const_reference at(size_type index) const{
+        if(index < size_){
+            return *slot(index);
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for ring of size " + std::to_string(size()));
+        }
+    }
+
+    reference front(){ return *slot(0); }
+    const_reference front() const{ return *slot(0); }
+    reference back(){ return *slot(size_ - 1); }
+    const_reference back() const{ return *slot(size_ - 1); }
+
+    /**
+     * @brief The elements are [first_segment(), second_segment()), each of them contiguous.
+     * The second segment is empty unless the elements wrap around the end of the array.
+     */
+    segment first_segment() noexcept{
+        return segment(alloc.arr + head_, size_ < growth.capacity - head_ ? size_ : growth.capacity - head_);
+    }
+
+    const_segment first_segment() const noexcept{
+        return const_segment(alloc.arr + head_, size_ < growth.capacity - head_ ? size_ : growth.capacity - head_);
+    }
+
+    segment second_segment() noexcept{
+        return segment(alloc.arr, size_ - first_segment().second);
+    }
+
+    const_segment second_segment() const noexcept{
+        return const_segment(alloc.arr, size_ - first_segment().second);
+    }
+
+    /**
+     * @brief Makes the elements contiguous, reallocating if they wrap around.
+     *
+     * @return pointer to the first element.
+     */
+    pointer linearize(){
+        if(second_segment().second){
+            reallocate(growth.capacity);
+        }
+        return alloc.arr + head_;
+    }
+
+    /**
+     * @brief Copies the elements into a devector.
+     */
+    template<class OffsetBy = rdsl::offset_by>
+    devector<value_type, allocator_type, OffsetBy, growth_policy_type> to_devector(const OffsetBy& offset_by = OffsetBy()) const{
+        return devector<value_type, allocator_type, OffsetBy, growth_policy_type>(begin(), end(), size_, alloc, offset_by);
+    }
+
+    void reserve(size_type n){
+        if(n > growth.capacity){
+            reallocate(n);
+        }
+    }
+
+    void shrink_to_fit(){
+        if(size_ != growth.capacity){
+            reallocate(size_);
+        }
+    }
+
+    void push_back(const_reference val){
+        emplace_back(val);
+    }
+
+    void push_back(value_type&& val){
+        emplace_back(std::move(val));
+    }
+
+    void push_front(const_reference val){
+        emplace_front(val);
+    }
+
+    void push_front(value_type&& val){
+        emplace_front(std::move(val));
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args){
+        make_room();
+        const pointer p = slot(size_);
+        al_traits<allocator_type>::construct(alloc, p, std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    template<class... Args>
+    reference emplace_front(Args&&... args){
+        make_room();
+        const size_type new_head = head_ ? head_ - 1 : growth.capacity - 1;
+        al_traits<allocator_type>::construct(alloc, alloc.arr + new_head, std::forward<Args>(args)...);
+        head_ = new_head;
+        ++size_;
+        return alloc.arr[new_head];
+    }
+
+    void pop_back() noexcept{
+        al_traits<allocator_type>::destroy(alloc, slot(size_ - 1));
+        --size_;
+    }
+
+    void pop_front() noexcept{
+        al_traits<allocator_type>::destroy(alloc, alloc.arr + head_);
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    void clear() noexcept{
+        destroy_all();
+    }
+
+    /**
+     * @brief Exchanges the elements & growth policies of both rings. Allocators are exchanged only if
+     * propagate_on_container_swap holds, otherwise elements are moved one by one when they compare unequal.
+     */
+    void swap(ring_devector& x){
+        // Arrays can't change hands between allocators that stay put & compare unequal.
+        if(!al_traits<allocator_type>::propagate_on_container_swap::value && alloc.get() != x.alloc.get()){
+            ring_devector temp(std::move(x));
+            x = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
+
+        std::swap(alloc.arr, x.alloc.arr);
+        std::swap(growth.capacity, x.growth.capacity);
+        std::swap(head_, x.head_);
+        std::swap(size_, x.size_);
+        std::swap(growth.get(), x.growth.get());
+        swap_allocator(x, typename al_traits<allocator_type>::propagate_on_container_swap());
+    }
+
+    allocator_type get_allocator() const noexcept{
+        return alloc;
+    }
+
+    growth_policy_type get_growth_policy() const noexcept{
+        return growth;
+    }
+};
+
+template<class T, class Alloc, class GrowthPolicy>
+void swap(ring_devector<T, Alloc, GrowthPolicy>& x, ring_devector<T, Alloc, GrowthPolicy>& y){
+    x.swap(y);
+}
+} //rdsl
+
+#endif
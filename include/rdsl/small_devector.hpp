@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * small_devector.hpp 0.0.0
+ *
+ * A header-only devector keeping short sequences in storage of its own, off the heap.
+ */
+
+
+#ifndef SMALL_DEVECTOR_RDSL_17102026
+#define SMALL_DEVECTOR_RDSL_17102026
+
+#include "devector.hpp"
+
+namespace rdsl{
+
+/**
+ * @brief Serves blocks of up to *N* elements from an arena of its own and anything larger, or anything
+ * requested while the arena is taken, from *Alloc*. Its *allocate_at_least* hands out the whole arena,
+ * so a devector using it owns capacity *N* right away & only reaches the heap once it outgrows it.
+ *
+ * The arena is part of the allocator & thus of the container holding it. Copies of the allocator start
+ * with an arena of their own, which is why two of them only compare equal, letting buffers change hands,
+ * while neither arena is in use.
+ */
+template<class T, size_t N, class Alloc = std::allocator<T>>
+struct small_buffer_allocator: private Alloc{
+    static_assert(N > 0, "small_buffer_allocator needs room for at least one element");
+
+    using upstream_allocator_type = Alloc;
+    using value_type = T;
+    using size_type = typename al_traits<Alloc>::size_type;
+    using difference_type = typename al_traits<Alloc>::difference_type;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    template<class U>
+    struct rebind{
+        using other = small_buffer_allocator<U, N, typename al_traits<Alloc>::template rebind_alloc<U>>;
+    };
+
+    small_buffer_allocator(const Alloc& upstream = Alloc()) noexcept
+    :Alloc(upstream) {}
+
+    small_buffer_allocator(const small_buffer_allocator& x) noexcept
+    :Alloc(x.upstream()) {}
+
+    template<class U, class A>
+    small_buffer_allocator(const small_buffer_allocator<U, N, A>& x) noexcept
+    :Alloc(x.upstream()) {}
+
+    small_buffer_allocator& operator=(const small_buffer_allocator&) = delete;
+
+    const Alloc& upstream() const noexcept{ return *this; }
+
+    allocation_result<T*, size_type> allocate_at_least(size_type n){
+        if(n <= N && !in_use){
+            in_use = true;
+            return {arena(), N};
+        }
+        return {al_traits<Alloc>::allocate(*this, n), n};
+    }
+
+    T* allocate(size_type n){
+        if(n <= N && !in_use){
+            in_use = true;
+            return arena();
+        }
+        return al_traits<Alloc>::allocate(*this, n);
+    }
+
+    void deallocate(T* p, size_type n) noexcept{
+        if(is_inline(p)){
+            in_use = false;
+        }else{
+            al_traits<Alloc>::deallocate(*this, p, n);
+        }
+    }
+
+    bool is_inline(const T* p) const noexcept{
+        return p == arena();
+    }
+
+    size_type inline_capacity() const noexcept{
+        return N;
+    }
+
+    template<class U, class... Args>
+    void construct(U* p, Args&&... args){
+        al_traits<Alloc>::construct(static_cast<Alloc&>(*this), p, std::forward<Args>(args)...);
+    }
+
+    template<class U>
+    void destroy(U* p){
+        al_traits<Alloc>::destroy(static_cast<Alloc&>(*this), p);
+    }
+
+    size_type max_size() const noexcept{
+        return al_traits<Alloc>::max_size(upstream());
+    }
+
+    template<class U, class A>
+    bool operator==(const small_buffer_allocator<U, N, A>& x) const noexcept{
+        return !in_use && !x.in_use && upstream() == x.upstream();
+    }
+
+    template<class U, class A>
+    bool operator!=(const small_buffer_allocator<U, N, A>& x) const noexcept{
+        return !(*this == x);
+    }
+
+private:
+    template<class U, size_t M, class A>
+    friend struct small_buffer_allocator;
+
+    T* arena() noexcept{ return reinterpret_cast<T*>(storage); }
+    const T* arena() const noexcept{ return reinterpret_cast<const T*>(storage); }
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    bool in_use = false;
+};
+
+/**
+ * @brief A devector holding up to *N* elements inline, without touching the heap. Beyond that it grows
+ * onto *Alloc* like any devector, and shrink_to_fit brings it back into its arena once it fits again.
+ */
+template<
+    class T,
+    size_t N,
+    class Alloc = std::allocator<T>,
+    class OffsetBy = rdsl::offset_by,
+    class GrowthPolicy = rdsl::geometric_growth<>,
+    class Stats = rdsl::no_stats
+>
+using small_devector = devector<T, small_buffer_allocator<T, N, Alloc>, OffsetBy, GrowthPolicy, Stats>;
+} //rdsl
+
+#endif
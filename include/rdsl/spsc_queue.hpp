@@ -0,0 +1,386 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * spsc_queue.hpp 0.0.0
+ *
+ * A header-only lock-free single-producer/single-consumer queue growing without blocking its consumer.
+ */
+
+#ifndef SPSC_QUEUE_RDSL_17102026
+#define SPSC_QUEUE_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace rdsl{
+
+/**
+ * @brief A lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Elements live in ring buffers called segments. Once the producer fills its segment it links
+ * a bigger one, sized by GrowthPolicy, and keeps on pushing there, while the consumer drains the
+ * old segment before following the link and freeing it. Neither side ever waits for the other.
+ *
+ * Each side caches the other side's index and only reloads it once that cached view runs out, and
+ * the bulk push & pop publish their whole batch with a single atomic store.
+ */
+template<typename T, class Alloc = std::allocator<T>, class GrowthPolicy = rdsl::geometric_growth<2, 1>>
+struct spsc_queue{
+    using value_type = T;
+    using allocator_type = Alloc;
+    using growth_policy_type = GrowthPolicy;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename al_traits<allocator_type>::pointer;
+    using size_type = typename al_traits<allocator_type>::size_type;
+
+private:
+    /**
+     * @brief A ring buffer of *capacity* slots, one of which is always left empty to tell a full ring from an empty one.
+     * *head* is only written by the consumer and *tail* by the producer, padded apart so they never share a cache line.
+     */
+    struct segment{
+        segment(pointer arr, size_type capacity) noexcept
+        :arr(arr), capacity(capacity), next(nullptr), head(0), tail(0) {}
+
+        size_type wrap(size_type index) const noexcept{
+            return index < capacity ? index : index - capacity;
+        }
+
+        size_type free(size_type head, size_type tail) const noexcept{
+            return head > tail ? head - tail - 1 : capacity - tail + head - 1;
+        }
+
+        size_type used(size_type head, size_type tail) const noexcept{
+            return tail >= head ? tail - head : capacity - head + tail;
+        }
+
+        const pointer arr;
+        const size_type capacity;
+        std::atomic<segment*> next;
+
+        char pad0[cache_line_size];
+        std::atomic<size_type> head;
+        char pad1[cache_line_size];
+        std::atomic<size_type> tail;
+        char pad2[cache_line_size];
+    };
+
+    using segment_allocator = typename al_traits<allocator_type>::template rebind_alloc<segment>;
+
+    struct compressed_alloc: public allocator_type{
+        compressed_alloc(const allocator_type& alloc = allocator_type())
+        :allocator_type(alloc)
+        {}
+
+        compressed_alloc(const compressed_alloc&) = delete;
+        compressed_alloc(compressed_alloc&&) noexcept = delete;
+        compressed_alloc& operator=(const compressed_alloc&) = delete;
+        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+
+        allocator_type& get() noexcept{ return *this; }
+        const allocator_type& get() const noexcept{ return *this; }
+
+        segment* consumer_segment;
+        size_type cached_tail;
+    }alloc;
+
+    struct compressed_growth: public growth_policy_type{
+        compressed_growth(const growth_policy_type& growth = growth_policy_type())
+        :growth_policy_type(growth)
+        {}
+
+        compressed_growth(const compressed_growth&) = delete;
+        compressed_growth(compressed_growth&&) noexcept = delete;
+        compressed_growth& operator=(const compressed_growth&) = delete;
+        compressed_growth& operator=(compressed_growth&&) noexcept = delete;
+
+        growth_policy_type& get() noexcept{ return *this; }
+        const growth_policy_type& get() const noexcept{ return *this; }
+
+        segment* producer_segment;
+        size_type cached_head;
+    };
+
+    // Keeps the consumer's state above and the producer's state below on separate cache lines.
+    char pad_[cache_line_size];
+    compressed_growth growth;
+
+    segment* create_segment(size_type capacity){
+        segment_allocator seg_alloc(alloc.get());
+        segment* const seg = al_traits<segment_allocator>::allocate(seg_alloc, 1);
+        pointer arr;
+        try{
+            arr = alloc.allocate(capacity);
+        }catch(...){
+            al_traits<segment_allocator>::deallocate(seg_alloc, seg, 1);
+            throw;
+        }
+        al_traits<segment_allocator>::construct(seg_alloc, seg, arr, capacity);
+        return seg;
+    }
+
+    void destroy_segment(segment* seg) noexcept{
+        size_type head = seg->head.load(std::memory_order_relaxed);
+        const size_type tail = seg->tail.load(std::memory_order_relaxed);
+        for(; head != tail; head = seg->wrap(head + 1)){
+            al_traits<allocator_type>::destroy(alloc, seg->arr + head);
+        }
+
+        alloc.deallocate(seg->arr, seg->capacity);
+
+        segment_allocator seg_alloc(alloc.get());
+        al_traits<segment_allocator>::destroy(seg_alloc, seg);
+        al_traits<segment_allocator>::deallocate(seg_alloc, seg, 1);
+    }
+
+    /**
+     * @brief Producer side. The number of slots that can be written in the producer's segment.
+     */
+    size_type writable(size_type tail, size_type needed) noexcept{
+        segment* const seg = growth.producer_segment;
+        size_type count = seg->free(growth.cached_head, tail);
+        if(count < needed){
+            growth.cached_head = seg->head.load(std::memory_order_acquire);
+            count = seg->free(growth.cached_head, tail);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Producer side. Links a new, bigger segment and continues pushing there.
+     * The old one is left to the consumer and never touched again by the producer.
+     */
+    void grow(){
+        segment* const seg = growth.producer_segment;
+        const size_type max = al_traits<allocator_type>::max_size(alloc);
+        const size_type new_capacity = growth.get().next_capacity(seg->capacity, max);
+        if(new_capacity <= seg->capacity){
+            throw std::length_error("spsc_queue cannot grow past max_size()");
+        }
+
+        segment* const next = create_segment(new_capacity);
+        growth.producer_segment = next;
+        growth.cached_head = 0;
+        seg->next.store(next, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer side. The number of slots that can be read in the consumer's segment,
+     * moving on to the next segment whenever the current one is drained for good.
+     */
+    size_type readable(size_type& head) noexcept{
+        for(;;){
+            segment* const seg = alloc.consumer_segment;
+            head = seg->head.load(std::memory_order_relaxed);
+            if(head == alloc.cached_tail){
+                alloc.cached_tail = seg->tail.load(std::memory_order_acquire);
+            }
+            if(head != alloc.cached_tail){
+                return seg->used(head, alloc.cached_tail);
+            }
+
+            segment* const next = seg->next.load(std::memory_order_acquire);
+            if(!next){
+                return 0;
+            }
+
+            // Elements published right before the link was made are visible now, drain them first.
+            alloc.cached_tail = seg->tail.load(std::memory_order_acquire);
+            if(head != alloc.cached_tail){
+                return seg->used(head, alloc.cached_tail);
+            }
+
+            alloc.consumer_segment = next;
+            alloc.cached_tail = 0;
+            destroy_segment(seg);
+        }
+    }
+
+public:
+
+    /**
+     * @brief *capacity* is the size of the first segment, at least 2.
+     */
+    explicit spsc_queue(
+        size_type capacity = 1024,
+        const allocator_type& allocator = allocator_type(),
+        const growth_policy_type& growth_policy = growth_policy_type()
+    )
+    :alloc(allocator), growth(growth_policy)
+    {
+        segment* const seg = create_segment(capacity < 2 ? 2 : capacity);
+        alloc.consumer_segment = growth.producer_segment = seg;
+        alloc.cached_tail = growth.cached_head = 0;
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue(){
+        segment* seg = alloc.consumer_segment;
+        while(seg){
+            segment* const next = seg->next.load(std::memory_order_relaxed);
+            destroy_segment(seg);
+            seg = next;
+        }
+    }
+
+    /**
+     * @brief Producer side. Never blocks, grows the queue when full.
+     */
+    template<class... Args>
+    void emplace(Args&&... args){
+        size_type tail = growth.producer_segment->tail.load(std::memory_order_relaxed);
+        if(!writable(tail, 1)){
+            grow();
+            tail = 0;
+        }
+
+        segment* const seg = growth.producer_segment;
+        al_traits<allocator_type>::construct(alloc, seg->arr + tail, std::forward<Args>(args)...);
+        seg->tail.store(seg->wrap(tail + 1), std::memory_order_release);
+    }
+
+    void push(const_reference val){
+        emplace(val);
+    }
+
+    void push(value_type&& val){
+        emplace(std::move(val));
+    }
+
+    /**
+     * @brief Producer side. Pushes *n* elements starting from *first*, publishing them with
+     * as few atomic stores as possible. If constructing an element throws, the ones before it remain queued.
+     */
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    void push(InputIterator first, size_type n){
+        while(n){
+            segment* seg = growth.producer_segment;
+            size_type tail = seg->tail.load(std::memory_order_relaxed);
+            size_type count = writable(tail, n);
+            if(!count){
+                grow();
+                seg = growth.producer_segment;
+                tail = 0;
+                count = seg->capacity - 1;
+            }
+            if(count > n){
+                count = n;
+            }
+
+            size_type written = 0;
+            try{
+                for(; written < count; ++written, ++first){
+                    al_traits<allocator_type>::construct(alloc, seg->arr + seg->wrap(tail + written), *first);
+                }
+            }catch(...){
+                seg->tail.store(seg->wrap(tail + written), std::memory_order_release);
+                throw;
+            }
+
+            seg->tail.store(seg->wrap(tail + count), std::memory_order_release);
+            n -= count;
+        }
+    }
+
+    /**
+     * @brief Consumer side. Moves the front element into *out*.
+     *
+     * @return false if the queue was empty.
+     */
+    bool try_pop(reference out){
+        size_type head;
+        if(!readable(head)){
+            return false;
+        }
+
+        segment* const seg = alloc.consumer_segment;
+        out = std::move(seg->arr[head]);
+        al_traits<allocator_type>::destroy(alloc, seg->arr + head);
+        seg->head.store(seg->wrap(head + 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Moves up to *max* elements into *out*, releasing each segment's
+     * slots back to the producer with a single atomic store.
+     *
+     * @return the number of elements popped.
+     */
+    template<class OutputIterator>
+    size_type pop(OutputIterator out, size_type max){
+        size_type popped = 0;
+        size_type head;
+        size_type count;
+
+        while(popped < max && (count = readable(head))){
+            if(count > max - popped){
+                count = max - popped;
+            }
+
+            segment* const seg = alloc.consumer_segment;
+            size_type i = 0;
+            try{
+                for(; i < count; ++i, ++out){
+                    const pointer p = seg->arr + seg->wrap(head + i);
+                    *out = std::move(*p);
+                    al_traits<allocator_type>::destroy(alloc, p);
+                }
+            }catch(...){
+                // The elements destroyed so far are released, the one that threw stays at the front.
+                seg->head.store(seg->wrap(head + i), std::memory_order_release);
+                throw;
+            }
+            seg->head.store(seg->wrap(head + count), std::memory_order_release);
+            popped += count;
+        }
+
+        return popped;
+    }
+
+    /**
+     * @brief Consumer side. Whether there's nothing to pop right now.
+     */
+    bool empty() noexcept{
+        size_type head;
+        return !readable(head);
+    }
+
+    allocator_type get_allocator() const noexcept{
+        return alloc;
+    }
+
+    growth_policy_type get_growth_policy() const noexcept{
+        return growth;
+    }
+};
+} //rdsl
+
+#endif
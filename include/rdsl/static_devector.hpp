@@ -0,0 +1,673 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * static_devector.hpp 0.0.0
+ *
+ * A header-only fixed capacity devector, storing its elements inside the object & never allocating.
+ */
+
+
+#ifndef STATIC_DEVECTOR_RDSL_17102026
+#define STATIC_DEVECTOR_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace rdsl{
+
+/**
+ * @brief Overflow policies of static_devector, told how many elements an operation needed room for.
+ * The operation is rejected once the policy returns, leaving the container as it was.
+ */
+struct throw_on_overflow{
+    static void overflow(size_t required, size_t capacity){
+        throw std::length_error(
+            "static_devector of capacity " + std::to_string(capacity) + " can't hold " + std::to_string(required) + " elements"
+        );
+    }
+};
+
+struct assert_on_overflow{
+    static void overflow(size_t, size_t) noexcept{
+        assert(!"static_devector capacity exceeded");
+    }
+};
+
+struct reject_on_overflow{
+    static void overflow(size_t, size_t) noexcept {}
+};
+
+/**
+ * @brief A devector of at most *N* elements, kept in an array inside the object itself. It never allocates:
+ * when an end runs out of room, the elements are slid inside the array to wherever *OffsetBy* places *begin*,
+ * and operations needing more than *N* elements report to *OverflowPolicy* and are rejected.
+ *
+ * Modifiers that may overflow tell whether they succeeded, push, emplace & resize ones by returning a bool,
+ * insert by returning *position* unchanged. Elements are shifted in place, so moving them must not throw.
+ */
+template<class T, size_t N, class OverflowPolicy = throw_on_overflow, class OffsetBy = rdsl::offset_by>
+struct static_devector{
+    static_assert(N > 0, "static_devector needs room for at least one element");
+    static_assert(is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value,
+        "static_devector shifts its elements in place, which needs moving them not to throw");
+
+    using value_type = T;
+    using overflow_policy_type = OverflowPolicy;
+    using offset_by_type = OffsetBy;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    struct compressed_offs: public offset_by_type{
+        compressed_offs(const offset_by_type& offs = offset_by_type())
+        :offset_by_type(offs)
+        {}
+
+        compressed_offs(const compressed_offs&) = delete;
+        compressed_offs(compressed_offs&&) noexcept = delete;
+        compressed_offs& operator=(const compressed_offs&) = delete;
+        compressed_offs& operator=(compressed_offs&&) noexcept = delete;
+
+        offset_by_type& get() noexcept{ return *this; }
+        const offset_by_type& get() const noexcept{ return *this; }
+
+        size_type head; // index of the first element inside the array
+        size_type size;
+    }offs;
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+
+    using relocation_tag = std::integral_constant<bool, is_trivially_relocatable<value_type>::value>;
+
+    pointer arr() noexcept{ return reinterpret_cast<pointer>(storage); }
+    const_pointer arr() const noexcept{ return reinterpret_cast<const_pointer>(storage); }
+
+    size_type free_front() const noexcept{ return offs.head; }
+    size_type free_back() const noexcept{ return N - offs.head - offs.size; }
+
+    size_type offset_for(offset_operation operation, size_type new_size){
+        const offset_context context{operation, N - new_size, new_size, N, N, free_front(), free_back()};
+        return offset_by_traits<offset_by_type>::off_by(offs, context);
+    }
+
+    /**
+     * @brief Whether *n* more elements fit, reporting to the overflow policy if they don't.
+     */
+    bool fits(size_type n){
+        if(n > N - offs.size){
+            overflow_policy_type::overflow(offs.size + n, N);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves *count* elements from slot *from* to slot *to*, the two ranges may overlap.
+     */
+    void relocate(size_type from, size_type count, size_type to) noexcept{
+        if(count && from != to){
+            relocate(arr() + from, count, arr() + to, relocation_tag());
+        }
+    }
+
+    static void relocate(pointer src, size_type count, pointer dst, std::true_type) noexcept{
+        std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(value_type));
+    }
+
+    static void relocate(pointer src, size_type count, pointer dst, std::false_type) noexcept{
+        if(dst < src){
+            for(size_type i = 0; i < count; ++i){
+                ::new(static_cast<void*>(dst + i)) value_type(std::move(src[i]));
+                src[i].~value_type();
+            }
+        }else{
+            for(size_type i = count; i--;){
+                ::new(static_cast<void*>(dst + i)) value_type(std::move(src[i]));
+                src[i].~value_type();
+            }
+        }
+    }
+
+    /**
+     * @brief Opens a gap of *n* unconstructed slots before the *index*-th element, which the caller has checked to fit.
+     * An end with room is used as is, a middle gap shifts the shorter side if it can, and anything else slides
+     * the elements to wherever *OffsetBy* places *begin*.
+     *
+     * @return pointer to the gap.
+     */
+    pointer open(size_type index, size_type n, offset_operation operation) noexcept{
+        const size_type size = offs.size;
+        size_type head;
+
+        if(index == size && free_back() >= n){
+            head = offs.head;
+        }else if(!index && free_front() >= n){
+            head = offs.head - n;
+        }else if(index && index != size && offset_by_traits<offset_by_type>::shift_shorter_side(offs)){
+            // The front side moves back by k, the rest of the gap comes out of the back side.
+            const size_type most = n < free_front() ? n : free_front();
+            const size_type least = n > free_back() ? n - free_back() : 0;
+            head = offs.head - (index <= size - index ? most : least);
+        }else{
+            head = offset_for(operation, size + n);
+        }
+
+        // Whichever side moves towards the other has to make way first.
+        if(head > offs.head){
+            relocate(offs.head + index, size - index, head + index + n);
+            relocate(offs.head, index, head);
+        }else{
+            relocate(offs.head, index, head);
+            relocate(offs.head + index, size - index, head + index + n);
+        }
+
+        offs.head = head;
+        offs.size += n;
+        return arr() + head + index;
+    }
+
+    /**
+     * @brief Closes a gap of *n* unconstructed slots at the *index*-th element, moving the shorter side over it.
+     */
+    void close(size_type index, size_type n) noexcept{
+        const size_type rest = offs.size - index - n;
+
+        if(index < rest && offset_by_traits<offset_by_type>::shift_shorter_side(offs)){
+            relocate(offs.head, index, offs.head + n);
+            offs.head += n;
+        }else{
+            relocate(offs.head + index + n, rest, offs.head + index);
+        }
+        offs.size -= n;
+    }
+
+    /**
+     * @brief Constructs *n* elements through construct(pointer) before the *index*-th one.
+     */
+    template<class Construct>
+    bool insert_impl(size_type index, size_type n, offset_operation operation, Construct construct){
+        if(!n){
+            return true;
+        }else if(!fits(n)){
+            return false;
+        }
+
+        const pointer gap = open(index, n, operation);
+        size_type built = 0;
+        try{
+            for(; built < n; ++built){
+                construct(gap + built);
+            }
+        }catch(...){
+            while(built){
+                gap[--built].~value_type();
+            }
+            close(index, n);
+            throw;
+        }
+
+        if(operation == offset_operation::push_front){
+            offset_by_traits<offset_by_type>::on_push_front(offs, n);
+        }else if(operation == offset_operation::push_back){
+            offset_by_traits<offset_by_type>::on_push_back(offs, n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replaces the elements with *n* constructed through construct(pointer), laid out as *OffsetBy* wants.
+     */
+    template<class Construct>
+    bool assign_impl(size_type n, offset_operation operation, Construct construct){
+        clear();
+        if(!fits(n)){
+            return false;
+        }
+
+        offs.head = offset_for(operation, n);
+        try{
+            for(const pointer first = arr() + offs.head; offs.size < n; ++offs.size){
+                construct(first + offs.size);
+            }
+        }catch(...){
+            clear();
+            throw;
+        }
+        return true;
+    }
+
+    template<class InputIterator>
+    bool insert_range(size_type index, InputIterator first, InputIterator last){
+        if(is_at_least_forward<typename it_traits<InputIterator>::iterator_category>::value){
+            return insert_impl(index, std::distance(first, last), offset_operation::insert, [&](pointer p){
+                ::new(static_cast<void*>(p)) value_type(*first);
+                ++first;
+            });
+        }
+
+        // The number of elements is unknown upfront, append them & rotate them into place.
+        const size_type old_size = offs.size;
+        try{
+            for(; first != last; ++first){
+                if(!emplace_back(*first)){
+                    pop_back_n(offs.size - old_size);
+                    return false;
+                }
+            }
+        }catch(...){
+            // Thrown by the overflow policy or an element's constructor, the appended elements go either way.
+            pop_back_n(offs.size - old_size);
+            throw;
+        }
+
+        std::rotate(begin() + index, begin() + old_size, end());
+        return true;
+    }
+
+    void pop_back_n(size_type n) noexcept{
+        offset_by_traits<offset_by_type>::on_pop_back(offs, n);
+        while(n--){
+            arr()[offs.head + --offs.size].~value_type();
+        }
+    }
+
+    void pop_front_n(size_type n) noexcept{
+        offset_by_traits<offset_by_type>::on_pop_front(offs, n);
+        while(n--){
+            arr()[offs.head++].~value_type();
+            --offs.size;
+        }
+    }
+
+public:
+
+    explicit static_devector(const offset_by_type& offset_by = offset_by_type())
+    :offs(offset_by)
+    {
+        offs.head = offs.size = 0;
+        offs.head = offset_for(offset_operation::construct, 0);
+    }
+
+    static_devector(size_type n, const_reference val, const offset_by_type& offset_by = offset_by_type())
+    :static_devector(offset_by)
+    {
+        assign_impl(n, offset_operation::construct, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(val); });
+    }
+
+    explicit static_devector(size_type n, const offset_by_type& offset_by = offset_by_type())
+    :static_devector(offset_by)
+    {
+        assign_impl(n, offset_operation::construct, [](pointer p){ ::new(static_cast<void*>(p)) value_type(); });
+    }
+
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    static_devector(InputIterator first, InputIterator last, const offset_by_type& offset_by = offset_by_type())
+    :static_devector(offset_by)
+    {
+        insert_range(0, first, last);
+    }
+
+    static_devector(std::initializer_list<value_type> il, const offset_by_type& offset_by = offset_by_type())
+    :static_devector(il.begin(), il.end(), offset_by)
+    {}
+
+    static_devector(const static_devector& x)
+    :static_devector(x.offs.get())
+    {
+        const_pointer src = x.begin();
+        assign_impl(x.size(), offset_operation::construct, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(*src++); });
+    }
+
+    /**
+     * @brief Moves the elements one by one, leaving *x* empty.
+     */
+    static_devector(static_devector&& x)
+    :static_devector(x.offs.get())
+    {
+        pointer src = x.begin();
+        assign_impl(x.size(), offset_operation::construct, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(std::move(*src++)); });
+        x.clear();
+    }
+
+    ~static_devector(){
+        clear();
+    }
+
+    static_devector& operator=(const static_devector& x){
+        if(this != &x){
+            offs.get() = x.offs.get();
+            const_pointer src = x.begin();
+            assign_impl(x.size(), offset_operation::assign, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(*src++); });
+        }
+        return *this;
+    }
+
+    static_devector& operator=(static_devector&& x){
+        if(this != &x){
+            offs.get() = std::move(x.offs.get());
+            pointer src = x.begin();
+            assign_impl(x.size(), offset_operation::assign, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(std::move(*src++)); });
+            x.clear();
+        }
+        return *this;
+    }
+
+    static_devector& operator=(std::initializer_list<value_type> il){
+        assign(il.begin(), il.end());
+        return *this;
+    }
+
+    bool assign(size_type n, const_reference val){
+        // val may refer to an element about to be destroyed.
+        const value_type copy(val);
+        return assign_impl(n, offset_operation::assign, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(copy); });
+    }
+
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    bool assign(InputIterator first, InputIterator last){
+        clear();
+        return insert_range(0, first, last);
+    }
+
+    bool assign(std::initializer_list<value_type> il){
+        return assign(il.begin(), il.end());
+    }
+
+    iterator begin() noexcept{ return arr() + offs.head; }
+    const_iterator begin() const noexcept{ return arr() + offs.head; }
+    iterator end() noexcept{ return begin() + offs.size; }
+    const_iterator end() const noexcept{ return begin() + offs.size; }
+    reverse_iterator rbegin() noexcept{ return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept{ return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept{ return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept{ return const_reverse_iterator(begin()); }
+    const_iterator cbegin() const noexcept{ return begin(); }
+    const_iterator cend() const noexcept{ return end(); }
+    const_reverse_iterator crbegin() const noexcept{ return rbegin(); }
+    const_reverse_iterator crend() const noexcept{ return rend(); }
+
+    size_type size() const noexcept{
+        return offs.size;
+    }
+
+    static constexpr size_type capacity() noexcept{
+        return N;
+    }
+
+    static constexpr size_type max_size() noexcept{
+        return N;
+    }
+
+    bool empty() const noexcept{
+        return !offs.size;
+    }
+
+    bool full() const noexcept{
+        return offs.size == N;
+    }
+
+    /**
+     * @brief Resizes the container by adding or removing elements at its front.
+     */
+    bool resize_front(size_type n){
+        if(n <= size()){
+            pop_front_n(size() - n);
+            return true;
+        }
+        return insert_impl(0, n - size(), offset_operation::resize_front, [](pointer p){ ::new(static_cast<void*>(p)) value_type(); });
+    }
+
+    bool resize_front(size_type n, const_reference val){
+        if(n <= size()){
+            pop_front_n(size() - n);
+            return true;
+        }
+        const value_type copy(val);
+        return insert_impl(0, n - size(), offset_operation::resize_front, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(copy); });
+    }
+
+    /**
+     * @brief Resizes the container by adding or removing elements at its back.
+     */
+    bool resize_back(size_type n){
+        if(n <= size()){
+            pop_back_n(size() - n);
+            return true;
+        }
+        return insert_impl(size(), n - size(), offset_operation::resize_back, [](pointer p){ ::new(static_cast<void*>(p)) value_type(); });
+    }
+
+    bool resize_back(size_type n, const_reference val){
+        if(n <= size()){
+            pop_back_n(size() - n);
+            return true;
+        }
+        const value_type copy(val);
+        return insert_impl(size(), n - size(), offset_operation::resize_back, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(copy); });
+    }
+
+    bool resize(size_type n){
+        return resize_back(n);
+    }
+
+    bool resize(size_type n, const_reference val){
+        return resize_back(n, val);
+    }
+
+    reference operator[](size_type index){
+        return begin()[index];
+    }
+
+    const_reference operator[](size_type index) const{
+        return begin()[index];
+    }
+
+    reference at(size_type index){
+        if(index < size()){
+            return begin()[index];
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for array of size " + std::to_string(size()));
+        }
+    }
+
+    const_reference at(size_type index) const{
+        if(index < size()){
+            return begin()[index];
+        }else{
+            throw std::out_of_range("index " + std::to_string(index) + " out of range for array of size " + std::to_string(size()));
+        }
+    }
+
+    reference front(){ return *begin(); }
+    const_reference front() const{ return *begin(); }
+    reference back(){ return end()[-1]; }
+    const_reference back() const{ return end()[-1]; }
+
+    pointer data() noexcept{ return begin(); }
+    const_pointer data() const noexcept{ return begin(); }
+
+    bool push_back(const_reference val){
+        return emplace_back(val);
+    }
+
+    bool push_back(value_type&& val){
+        return emplace_back(std::move(val));
+    }
+
+    bool push_front(const_reference val){
+        return emplace_front(val);
+    }
+
+    bool push_front(value_type&& val){
+        return emplace_front(std::move(val));
+    }
+
+    template<class... Args>
+    bool emplace_back(Args&&... args){
+        return insert_impl(size(), 1, offset_operation::push_back, [&](pointer p){
+            ::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+        });
+    }
+
+    template<class... Args>
+    bool emplace_front(Args&&... args){
+        return insert_impl(0, 1, offset_operation::push_front, [&](pointer p){
+            ::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+        });
+    }
+
+    void pop_back() noexcept{
+        pop_back_n(1);
+    }
+
+    void pop_front() noexcept{
+        pop_front_n(1);
+    }
+
+    template<class... Args>
+    iterator emplace(const_iterator position, Args&&... args){
+        const size_type index = position - begin();
+        insert_impl(index, 1, offset_operation::insert, [&](pointer p){
+            ::new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+        });
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator position, const_reference val){
+        return emplace(position, val);
+    }
+
+    iterator insert(const_iterator position, value_type&& val){
+        return emplace(position, std::move(val));
+    }
+
+    iterator insert(const_iterator position, size_type n, const_reference val){
+        const size_type index = position - begin();
+        const value_type copy(val);
+        insert_impl(index, n, offset_operation::insert, [&](pointer p){ ::new(static_cast<void*>(p)) value_type(copy); });
+        return begin() + index;
+    }
+
+    template<class InputIterator, is_iterator<InputIterator> = 0>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last){
+        const size_type index = position - begin();
+        insert_range(index, first, last);
+        return begin() + index;
+    }
+
+    iterator insert(const_iterator position, std::initializer_list<value_type> il){
+        return insert(position, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator first, const_iterator last){
+        const size_type index = first - begin();
+        const size_type n = last - first;
+
+        if(!index){
+            pop_front_n(n);
+        }else if(index + n == size()){
+            pop_back_n(n);
+        }else{
+            for(pointer p = begin() + index; p != begin() + index + n; ++p){
+                p->~value_type();
+            }
+            close(index, n);
+        }
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator position){
+        return erase(position, position + 1);
+    }
+
+    void clear() noexcept{
+        pop_back_n(size());
+    }
+
+    /**
+     * @brief Exchanges the elements & offset policies of both containers, moving the elements one by one.
+     */
+    void swap(static_devector& x){
+        static_devector temp(std::move(x));
+        x = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    offset_by_type get_offset_by() const noexcept{
+        return offs;
+    }
+};
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator== (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator!= (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return !(lhs == rhs);
+}
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator< (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator<= (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return !(rhs < lhs);
+}
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator> (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return rhs < lhs;
+}
+
+template<class T, size_t N, size_t M, class OverflowA, class OverflowB, class OffsetByA, class OffsetByB>
+bool operator>= (const static_devector<T, N, OverflowA, OffsetByA>& lhs, const static_devector<T, M, OverflowB, OffsetByB>& rhs){
+    return !(lhs < rhs);
+}
+
+template<class T, size_t N, class OverflowPolicy, class OffsetBy>
+void swap(static_devector<T, N, OverflowPolicy, OffsetBy>& x, static_devector<T, N, OverflowPolicy, OffsetBy>& y){
+    x.swap(y);
+}
+} //rdsl
+
+#endif
@@ -0,0 +1,187 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * virtual_allocator.hpp 0.0.0
+ *
+ * A header-only allocator reserving address space up front & committing it as blocks grow at either end.
+ */
+
+
+#ifndef VIRTUAL_ALLOCATOR_RDSL_17102026
+#define VIRTUAL_ALLOCATOR_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#if !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+namespace rdsl{
+
+// Address space a virtual_allocator reserves per block, 64GiB where pointers are wide enough.
+constexpr size_t virtual_reserve = sizeof(void*) >= 8 ? size_t(1) << 36 : size_t(1) << 28;
+
+/**
+ * @brief Reserves *Reserve* bytes of address space per block, a power of two, & places the block in its middle.
+ * Only the pages a block covers are committed, and *extend* commits more of them as the block grows at either end,
+ * so a devector using it grows without ever moving its elements & its iterators stay valid, until the reservation
+ * runs out. Only then does it allocate a new block and move the elements over, like any devector. A devector still
+ * recenters its elements when plenty of the block is free, e.g. when used as a queue, and *discard* gives back
+ * the pages they leave behind.
+ *
+ * Reservations are aligned to their size, which is how a block's reservation is found from its address alone.
+ */
+template<class T, size_t Reserve = virtual_reserve>
+struct virtual_allocator{
+    static_assert(Reserve && !(Reserve & (Reserve - 1)), "virtual_allocator needs a power of two reservation");
+
+    using value_type = T;
+    using pointer = T*;
+    using size_type = size_t;
+
+    template<class U>
+    struct rebind{
+        using other = virtual_allocator<U, Reserve>;
+    };
+
+    virtual_allocator() noexcept = default;
+
+    template<class U>
+    virtual_allocator(const virtual_allocator<U, Reserve>&) noexcept {}
+
+    pointer allocate(size_type n){
+        if(!n){
+            return nullptr;
+        }else if(n > max_size()){
+            throw std::bad_alloc();
+        }
+
+        // Twice the size is mapped, so that an aligned reservation can be cut out of it.
+        void* const mapped = ::mmap(nullptr, 2 * Reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if(mapped == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+
+        const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(mapped);
+        const std::uintptr_t base = (first + Reserve - 1) & ~std::uintptr_t(Reserve - 1);
+        if(base != first){
+            ::munmap(mapped, base - first);
+        }
+        ::munmap(reinterpret_cast<void*>(base + Reserve), first + Reserve - base);
+
+        const size_t bytes = n * sizeof(T);
+        const std::uintptr_t p = (base + (Reserve - bytes) / 2) & ~std::uintptr_t(alignof(T) - 1);
+        if(!commit(p, p + bytes)){
+            ::munmap(reinterpret_cast<void*>(base), Reserve);
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type) noexcept{
+        if(p){
+            ::munmap(reinterpret_cast<void*>(reservation(p)), Reserve);
+        }
+    }
+
+    /**
+     * @brief Grows the block of *n* elements at *p* by *front* elements before it & *back* after it, in place.
+     *
+     * @return the block's new start, or nullptr if it would leave its reservation or the pages can't be committed.
+     */
+    pointer extend(pointer p, size_type n, size_type front, size_type back) noexcept{
+        const std::uintptr_t base = reservation(p);
+        const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(p);
+
+        if(front > (first - base) / sizeof(T) || n + back > (base + Reserve - first) / sizeof(T)){
+            return nullptr;
+        }
+
+        const std::uintptr_t new_first = first - front * sizeof(T);
+        if(!commit(new_first, first + (n + back) * sizeof(T))){
+            return nullptr;
+        }
+        return reinterpret_cast<pointer>(new_first);
+    }
+
+    /**
+     * @brief Gives the pages lying entirely inside [first, last) back to the system, they read as zeroes once touched again.
+     */
+    void discard(pointer first, pointer last) noexcept{
+        const std::uintptr_t page = page_size();
+        const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(first) + page - 1) & ~(page - 1);
+        const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(last) & ~(page - 1);
+
+        if(begin < end){
+            ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+        }
+    }
+
+    static constexpr size_type max_size() noexcept{
+        return Reserve / sizeof(T);
+    }
+
+    template<class U>
+    bool operator==(const virtual_allocator<U, Reserve>&) const noexcept{ return true; }
+
+    template<class U>
+    bool operator!=(const virtual_allocator<U, Reserve>&) const noexcept{ return false; }
+
+private:
+    static std::uintptr_t reservation(pointer p) noexcept{
+        return reinterpret_cast<std::uintptr_t>(p) & ~std::uintptr_t(Reserve - 1);
+    }
+
+    static std::uintptr_t page_size() noexcept{
+        static const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    // Makes the pages covering [first, last) readable & writable, physical memory is still only faulted in on first touch.
+    static bool commit(std::uintptr_t first, std::uintptr_t last) noexcept{
+        const std::uintptr_t page = page_size();
+
+        first &= ~(page - 1);
+        last = (last + page - 1) & ~(page - 1);
+        return last == first || !::mprotect(reinterpret_cast<void*>(first), last - first, PROT_READ | PROT_WRITE);
+    }
+};
+
+template<class T, class OffsetBy = rdsl::offset_by, class GrowthPolicy = rdsl::geometric_growth<>, class Stats = rdsl::no_stats>
+using virtual_devector = devector<T, virtual_allocator<T>, OffsetBy, GrowthPolicy, Stats>;
+} //rdsl
+
+#endif
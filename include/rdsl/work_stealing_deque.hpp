@@ -0,0 +1,277 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * MIT License
+ *
+ * Copyright (c) 2022 Valasiadis Fotios
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * work_stealing_deque.hpp 0.0.0
+ *
+ * A header-only Chase-Lev work-stealing deque: its owner pushes & pops at the back while thieves steal from the front.
+ */
+
+#ifndef WORK_STEALING_DEQUE_RDSL_17102026
+#define WORK_STEALING_DEQUE_RDSL_17102026
+
+#include "devector.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace rdsl{
+
+/**
+ * @brief The dynamic circular work-stealing deque of Chase & Lev, with the memory orderings of
+ * Lê, Pop, Cohen & Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+ *
+ * Only the owning thread may call push_back and pop_back, any thread may call steal_front.
+ * Thieves read an element before they know whether they won it, which is why T has to be
+ * trivially copyable; store pointers or indices to bigger tasks.
+ *
+ * Storage doubles when full. Thieves may still be reading an outgrown array, so those are kept
+ * around until the deque is destroyed, which costs at most as much memory as the current array.
+ */
+template<typename T, class Alloc = std::allocator<T>>
+struct work_stealing_deque{
+    static_assert(std::is_trivially_copyable<T>::value, "work_stealing_deque elements must be trivially copyable");
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = typename al_traits<allocator_type>::size_type;
+    using difference_type = typename al_traits<allocator_type>::difference_type;
+
+private:
+    using slot = std::atomic<value_type>;
+    using slot_allocator = typename al_traits<allocator_type>::template rebind_alloc<slot>;
+
+    /**
+     * @brief A power of two sized circular array, indexed by the ever increasing top & bottom.
+     */
+    struct ring{
+        ring(slot* slots, size_type capacity) noexcept
+        :slots(slots), capacity(capacity) {}
+
+        value_type load(difference_type index) const noexcept{
+            return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void store(difference_type index, const_reference val) noexcept{
+            slots[index & (capacity - 1)].store(val, std::memory_order_relaxed);
+        }
+
+        slot* const slots;
+        const size_type capacity;
+    };
+
+    using ring_allocator = typename al_traits<allocator_type>::template rebind_alloc<ring>;
+    using retired_allocator = typename al_traits<allocator_type>::template rebind_alloc<ring*>;
+
+    struct compressed_alloc: public allocator_type{
+        compressed_alloc(const allocator_type& alloc = allocator_type())
+        :allocator_type(alloc), retired(retired_allocator(alloc))
+        {}
+
+        compressed_alloc(const compressed_alloc&) = delete;
+        compressed_alloc(compressed_alloc&&) noexcept = delete;
+        compressed_alloc& operator=(const compressed_alloc&) = delete;
+        compressed_alloc& operator=(compressed_alloc&&) noexcept = delete;
+
+        allocator_type& get() noexcept{ return *this; }
+        const allocator_type& get() const noexcept{ return *this; }
+
+        std::atomic<ring*> arr;
+        devector<ring*, retired_allocator> retired; // outgrown arrays, only touched by the owner
+    }alloc;
+
+    // top is written by thieves, bottom by the owner, padded apart so they never share a cache line.
+    char pad0_[cache_line_size];
+    std::atomic<difference_type> top_;
+    char pad1_[cache_line_size];
+    std::atomic<difference_type> bottom_;
+    char pad2_[cache_line_size];
+
+    ring* create_ring(size_type capacity){
+        slot_allocator slot_alloc(alloc.get());
+        ring_allocator ring_alloc(alloc.get());
+
+        slot* const slots = al_traits<slot_allocator>::allocate(slot_alloc, capacity);
+        for(size_type i = 0; i < capacity; ++i){
+            al_traits<slot_allocator>::construct(slot_alloc, slots + i);
+        }
+
+        ring* r;
+        try{
+            r = al_traits<ring_allocator>::allocate(ring_alloc, 1);
+        }catch(...){
+            al_traits<slot_allocator>::deallocate(slot_alloc, slots, capacity);
+            throw;
+        }
+        al_traits<ring_allocator>::construct(ring_alloc, r, slots, capacity);
+        return r;
+    }
+
+    void destroy_ring(ring* r) noexcept{
+        slot_allocator slot_alloc(alloc.get());
+        ring_allocator ring_alloc(alloc.get());
+
+        for(size_type i = 0; i < r->capacity; ++i){
+            al_traits<slot_allocator>::destroy(slot_alloc, r->slots + i);
+        }
+        al_traits<slot_allocator>::deallocate(slot_alloc, r->slots, r->capacity);
+
+        al_traits<ring_allocator>::destroy(ring_alloc, r);
+        al_traits<ring_allocator>::deallocate(ring_alloc, r, 1);
+    }
+
+    /**
+     * @brief Owner side. Copies [top, bottom) into an array twice the size and publishes it.
+     */
+    ring* grow(ring* old, difference_type top, difference_type bottom){
+        alloc.retired.reserve(alloc.retired.size() + 1);
+        ring* const r = create_ring(old->capacity * 2);
+        for(difference_type i = top; i < bottom; ++i){
+            r->store(i, old->load(i));
+        }
+
+        alloc.retired.push_back(old);
+        alloc.arr.store(r, std::memory_order_release);
+        return r;
+    }
+
+public:
+
+    /**
+     * @brief *capacity* is rounded up to a power of two.
+     */
+    explicit work_stealing_deque(size_type capacity = 1024, const allocator_type& allocator = allocator_type())
+    :alloc(allocator), top_(0), bottom_(0)
+    {
+        const size_type max = al_traits<allocator_type>::max_size(alloc);
+        alloc.arr.store(create_ring(power_of_two_growth::capacity_to_fit(0, capacity, max)), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    ~work_stealing_deque(){
+        destroy_ring(alloc.arr.load(std::memory_order_relaxed));
+        for(ring* r: alloc.retired){
+            destroy_ring(r);
+        }
+    }
+
+    /**
+     * @brief Owner side.
+     */
+    void push_back(const_reference val){
+        const difference_type bottom = bottom_.load(std::memory_order_relaxed);
+        const difference_type top = top_.load(std::memory_order_acquire);
+        ring* r = alloc.arr.load(std::memory_order_relaxed);
+
+        if(bottom - top > static_cast<difference_type>(r->capacity) - 1){
+            r = grow(r, top, bottom);
+        }
+
+        r->store(bottom, val);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Owner side. Takes the most recently pushed element.
+     *
+     * @return false if the deque was empty.
+     */
+    bool pop_back(reference out){
+        const difference_type bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* const r = alloc.arr.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        difference_type top = top_.load(std::memory_order_relaxed);
+
+        if(top > bottom){
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = r->load(bottom);
+        if(top == bottom){
+            // Last element, race the thieves for it.
+            const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Any thread. Takes the least recently pushed element.
+     *
+     * @return false if the deque was empty or another thread got the element first.
+     */
+    bool steal_front(reference out){
+        difference_type top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const difference_type bottom = bottom_.load(std::memory_order_acquire);
+
+        if(top >= bottom){
+            return false;
+        }
+
+        // Acquire rather than consume, which compilers promote to acquire anyway.
+        const ring* const r = alloc.arr.load(std::memory_order_acquire);
+        const value_type val = r->load(top);
+        if(!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+            return false;
+        }
+
+        out = val;
+        return true;
+    }
+
+    /**
+     * @brief A snapshot that may be outdated by the time it's returned, if other threads are active.
+     */
+    size_type size() const noexcept{
+        const difference_type bottom = bottom_.load(std::memory_order_relaxed);
+        const difference_type top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+    }
+
+    bool empty() const noexcept{
+        return !size();
+    }
+
+    size_type capacity() const noexcept{
+        return alloc.arr.load(std::memory_order_relaxed)->capacity;
+    }
+
+    allocator_type get_allocator() const noexcept{
+        return alloc;
+    }
+};
+} //rdsl
+
+#endif
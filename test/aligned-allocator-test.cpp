@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "rdsl/aligned_allocator.hpp"
+
+#include <cstdint>
+
+template<class T, size_t Alignment, bool HugePages = false>
+using aligned = rdsl::devector<T, rdsl::aligned_allocator<T, Alignment, HugePages>, rdsl::aligned_offset_by<T, Alignment>>;
+
+template<class It>
+static size_t misalignment(It it, size_t alignment){
+    return reinterpret_cast<std::uintptr_t>(&*it) % alignment;
+}
+
+TEST(AlignedAllocatorTest, BeginTest) {
+    aligned<float, 64> vec(1000, 1.0f);
+    EXPECT_EQ(misalignment(vec.data(), 64), 0);
+    EXPECT_EQ(misalignment(vec.begin(), 64), 0);
+
+    for(int i = 0; i < 5000; ++i){
+        vec.push_back(float(i));
+    }
+    vec.reserve(vec.capacity() + 3);
+    EXPECT_EQ(misalignment(vec.begin(), 64), 0);
+
+    vec.insert(vec.begin() + 77, 5, 2.0f);
+    EXPECT_EQ(misalignment(vec.begin(), 64), 0);
+
+    vec.erase(vec.begin() + 3, vec.begin() + 30);
+    EXPECT_EQ(misalignment(vec.begin(), 64), 0);
+
+    for(int i = 0; i < 5000; ++i){
+        vec.push_front(float(i));
+    }
+    vec.resize_front(vec.capacity() + 1);
+    EXPECT_EQ(misalignment(vec.begin(), 64), 0);
+
+    // Elements that don't divide the alignment.
+    struct odd{
+        char bytes[24];
+    };
+    aligned<odd, 32> odds(100);
+    odds.reserve(1000);
+    EXPECT_EQ(misalignment(odds.begin(), 32), 0);
+    EXPECT_EQ((rdsl::aligned_offset_by<odd, 32>::step()), 4);
+}
+
+TEST(AlignedAllocatorTest, HugePageTest) {
+    aligned<double, 4096, true> vec;
+    vec.reserve(rdsl::huge_page_size); // in elements, so well above a huge page in bytes
+    EXPECT_EQ(misalignment(vec.data(), rdsl::huge_page_size), 0);
+    EXPECT_EQ(misalignment(vec.begin(), 4096), 0);
+
+    vec.resize_back(1000, 3.0);
+    vec.shrink_to_fit();
+    EXPECT_EQ(misalignment(vec.data(), 4096), 0);
+    EXPECT_EQ(vec.back(), 3.0);
+}
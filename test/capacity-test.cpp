@@ -1,6 +1,36 @@
 #include <gtest/gtest.h>
 #include "rdsl/devector.hpp"
 
+#include <string>
+
+static size_t live_blocks = 0;
+
+template<class T>
+struct block_counting_allocator{
+    using value_type = T;
+
+    block_counting_allocator() = default;
+
+    template<class U>
+    block_counting_allocator(const block_counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n){
+        ++live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept{
+        --live_blocks;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(const block_counting_allocator<U>&) const noexcept{ return true; }
+
+    template<class U>
+    bool operator!=(const block_counting_allocator<U>&) const noexcept{ return false; }
+};
+
 TEST(CapacityTest, ALL) {
     rdsl::devector<int> vec(10,20);
 
@@ -31,4 +61,168 @@ TEST(CapacityTest, ALL) {
     EXPECT_EQ(vec.size(), 10);
     EXPECT_GE(vec.capacity(), 10);
     EXPECT_FALSE(vec.empty());
-}
\ No newline at end of file
+}
+TEST(CapacityTest, GrowthPolicyTest) {
+    const size_t max = static_cast<size_t>(-1);
+
+    EXPECT_EQ(rdsl::geometric_growth<>::next_capacity(0, max), 1);
+    EXPECT_EQ(rdsl::geometric_growth<>::next_capacity(4, max), 7);
+    EXPECT_EQ(rdsl::geometric_growth<>::next_capacity(12, max), 20);
+    EXPECT_EQ(rdsl::geometric_growth<>::next_capacity(max / 8 * 5, max), max);
+    EXPECT_EQ(rdsl::geometric_growth<>::capacity_to_fit(4, 100, max), 100);
+    EXPECT_EQ((rdsl::geometric_growth<2, 1>::next_capacity(1000, max)), 2001);
+
+    EXPECT_EQ(rdsl::power_of_two_growth::next_capacity(0, max), 1);
+    EXPECT_EQ(rdsl::power_of_two_growth::next_capacity(16, max), 32);
+    EXPECT_EQ(rdsl::power_of_two_growth::capacity_to_fit(16, 33, max), 64);
+    EXPECT_EQ(rdsl::power_of_two_growth::capacity_to_fit(0, max / 2 + 2, max), max);
+
+    EXPECT_EQ(rdsl::chunked_growth<64>::next_capacity(0, max), 64);
+    EXPECT_EQ(rdsl::chunked_growth<64>::next_capacity(64, max), 128);
+    EXPECT_EQ(rdsl::chunked_growth<64>::capacity_to_fit(0, 65, max), 128);
+    EXPECT_EQ(rdsl::chunked_growth<64>::capacity_to_fit(0, 128, max), 128);
+    EXPECT_EQ(rdsl::chunked_growth<64>::next_capacity(max - 10, max), max);
+
+    rdsl::devector<int, std::allocator<int>, rdsl::offset_by, rdsl::power_of_two_growth> pow2;
+    rdsl::devector<int, std::allocator<int>, rdsl::offset_by, rdsl::chunked_growth<100>> chunked;
+    for(int i = 0; i < 1000; ++i){
+        pow2.push_back(i);
+        chunked.push_front(i);
+        EXPECT_EQ(pow2.capacity() & (pow2.capacity() - 1), 0);
+        EXPECT_EQ(chunked.capacity() % 100, 0);
+    }
+    EXPECT_LE(pow2.capacity(), 2048);
+    EXPECT_LE(chunked.capacity(), 1100);
+
+    pow2.shrink_to_fit();
+    pow2.insert(pow2.begin() + 10, 100, 3);
+    EXPECT_EQ(pow2.capacity(), 2048);
+
+    auto copy = chunked;
+    copy.resize_back(chunked.capacity() + 1);
+    EXPECT_EQ(copy.capacity(), chunked.capacity() + 100);
+}
+
+TEST(CapacityTest, ResizeTest) {
+    using counted = rdsl::devector<float, std::allocator<float>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats>;
+
+    counted vec(4, 1.0f);
+    vec.resize_back(1000, 2.0f);
+    EXPECT_EQ(vec.stats().reallocations, 1);
+    vec.resize_front(2000, 3.0f);
+    EXPECT_EQ(vec.stats().reallocations, 2);
+
+    ASSERT_EQ(vec.size(), 2000);
+    EXPECT_EQ(vec[0], 3.0f);
+    EXPECT_EQ(vec[999], 3.0f);
+    EXPECT_EQ(vec[1000], 1.0f);
+    EXPECT_EQ(vec[1004], 2.0f);
+    EXPECT_EQ(vec[1999], 2.0f);
+
+    vec.resize_front(1500);
+    vec.resize_back(10);
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_EQ(vec[0], 3.0f);
+    EXPECT_EQ(vec.stats().destroyed, 1990);
+
+    float* const data = vec.data();
+    vec.resize_back_for_overwrite(vec.capacity() / 2);
+    vec.resize_front_for_overwrite(vec.capacity());
+    EXPECT_EQ(vec.data(), data);
+    EXPECT_EQ(vec.size(), vec.capacity());
+    EXPECT_EQ(vec.stats().constructed - vec.stats().destroyed, vec.size());
+
+    // Types that aren't trivial are still default constructed.
+    rdsl::devector<std::string> strings{"a"};
+    strings.resize_back_for_overwrite(3);
+    strings.resize_front_for_overwrite(5);
+    EXPECT_EQ(strings, (rdsl::devector<std::string>{"", "", "a", "", ""}));
+    strings.resize_front_for_overwrite(2);
+    EXPECT_EQ(strings, (rdsl::devector<std::string>{"", ""}));
+}
+
+TEST(CapacityTest, ShrinkPolicyTest) {
+    using shrinking = rdsl::devector<int, std::allocator<int>, rdsl::offset_by, rdsl::hysteresis_shrink<>, rdsl::devector_stats>;
+
+    EXPECT_EQ(rdsl::hysteresis_shrink<>().shrink_capacity(1000, 250), 1000);
+    EXPECT_EQ(rdsl::hysteresis_shrink<>().shrink_capacity(1000, 249), 498);
+    EXPECT_EQ(rdsl::hysteresis_shrink<>().shrink_capacity(1000, 3), 16);
+    EXPECT_EQ(rdsl::hysteresis_shrink<>().shrink_capacity(16, 0), 16);
+    static_assert(!rdsl::growth_policy_traits<rdsl::geometric_growth<>>::shrinks, "geometric_growth never shrinks");
+    static_assert(rdsl::growth_policy_traits<rdsl::hysteresis_shrink<>>::shrinks, "hysteresis_shrink shrinks");
+
+    // A burst, drained from the front like a queue.
+    shrinking queue;
+    for(int i = 0; i < 100000; ++i){
+        queue.push_back(i);
+    }
+    const size_t peak = queue.capacity();
+    int expected = 0;
+    while(queue.size() > 10){
+        ASSERT_EQ(queue.front(), expected++);
+        queue.pop_front();
+        ASSERT_GE(queue.size() * 4 + 4, queue.capacity() > 16 ? queue.capacity() : 0);
+    }
+    EXPECT_LE(queue.capacity(), 40);
+    EXPECT_GT(queue.stats().bytes_released, (peak - 40) * sizeof(int));
+    EXPECT_EQ(queue.front(), expected);
+
+    // Hovering around a capacity boundary reallocates once, not back & forth.
+    queue.clear();
+    EXPECT_EQ(queue.capacity(), 16);
+    for(int i = 0; i < 100; ++i){
+        queue.push_back(i);
+    }
+    const size_t reallocations = queue.stats().reallocations;
+    for(int i = 0; i < 1000; ++i){
+        queue.pop_back();
+        queue.pop_back();
+        queue.push_back(i);
+        queue.push_back(i);
+    }
+    EXPECT_EQ(queue.stats().reallocations, reallocations);
+
+    // Erasing & resizing shrink too, erase still pointing past the erased elements.
+    const auto it = queue.erase(queue.begin() + 5, queue.end() - 5);
+    EXPECT_EQ(it - queue.begin(), 5);
+    EXPECT_EQ(queue.size(), 10);
+    EXPECT_EQ(queue.capacity(), 20);
+    queue.resize_back(100);
+    queue.resize_front(3);
+    EXPECT_EQ(queue.capacity(), 16);
+
+    // shrink_to_fit leaves a container that's already tight alone.
+    rdsl::devector<int, std::allocator<int>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats> tight(50, 1);
+    const int* const data = tight.data();
+    tight.shrink_to_fit();
+    EXPECT_EQ(tight.data(), data);
+    EXPECT_EQ(tight.stats().reallocations, 0);
+    EXPECT_EQ(tight.stats().bytes_released, 0);
+
+    tight.reserve(80);
+    tight.shrink_to_fit();
+    EXPECT_EQ(tight.capacity(), 50);
+    EXPECT_EQ(tight.stats().bytes_released, 30 * sizeof(int));
+}
+
+TEST(CapacityTest, EmptyShrinkTest) {
+    {
+        rdsl::devector<int, block_counting_allocator<int>> vec;
+        for(int i = 0; i < 10; ++i){
+            vec.push_back(i);
+        }
+        EXPECT_EQ(live_blocks, 1);
+
+        // An empty container gives its block back instead of trading it for a 0 slot one.
+        vec.clear();
+        vec.shrink_to_fit();
+        EXPECT_EQ(vec.capacity(), 0);
+        EXPECT_EQ(live_blocks, 0);
+
+        vec.push_front(1);
+        vec.push_back(2);
+        EXPECT_EQ(vec, (rdsl::devector<int, block_counting_allocator<int>>{1, 2}));
+        EXPECT_EQ(live_blocks, 1);
+    }
+    EXPECT_EQ(live_blocks, 0);
+}
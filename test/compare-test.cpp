@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "rdsl/devector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace{
+
+enum class color: std::uint16_t{ red, green, blue };
+
+// Every length around the register widths, with the difference at every position.
+template<class T>
+void check_compare(T low, T high){
+    for(size_t n = 0; n < 70; ++n){
+        const rdsl::devector<T> base(n, low);
+        for(size_t i = 0; i < n; ++i){
+            rdsl::devector<T> other = base;
+            other[i] = high;
+            EXPECT_FALSE(base == other);
+            EXPECT_TRUE(base != other);
+            EXPECT_TRUE(base < other);
+            EXPECT_FALSE(other < base);
+            EXPECT_TRUE(other > base);
+        }
+
+        rdsl::devector<T> copy = base;
+        EXPECT_TRUE(base == copy);
+        EXPECT_FALSE(base < copy);
+        EXPECT_TRUE(base <= copy);
+
+        copy.push_back(low);
+        EXPECT_TRUE(base < copy);
+        EXPECT_FALSE(base == copy);
+        EXPECT_TRUE(copy >= base);
+    }
+}
+
+template<class T>
+void check_search(std::mt19937& gen){
+    std::uniform_int_distribution<int> pick(0, 3);
+    for(size_t n = 0; n < 200; n += 7){
+        rdsl::devector<T> vec;
+        for(size_t i = 0; i < n; ++i){
+            vec.push_back(static_cast<T>(pick(gen)));
+        }
+
+        for(int v = 0; v < 5; ++v){
+            const T val = static_cast<T>(v);
+            EXPECT_EQ(vec.find(val), std::find(vec.begin(), vec.end(), val));
+            EXPECT_EQ(vec.count(val), static_cast<size_t>(std::count(vec.begin(), vec.end(), val)));
+            EXPECT_EQ(vec.contains(val), std::find(vec.begin(), vec.end(), val) != vec.end());
+        }
+    }
+}
+
+} //namespace
+
+TEST(CompareTest, ComparisonTest) {
+    check_compare<std::int8_t>(-3, 7);
+    check_compare<std::uint8_t>(3, 200);
+    check_compare<std::int32_t>(-1, 1);
+    check_compare<std::uint64_t>(1, std::uint64_t(1) << 63);
+    check_compare<color>(color::green, color::blue);
+    check_compare<std::string>("a", "b");
+
+    // Only the first differing element decides, whatever its bytes look like.
+    rdsl::devector<std::int32_t> a{1, 2, 0x100, 4};
+    rdsl::devector<std::int32_t> b{1, 2, 0x001, 5};
+    EXPECT_TRUE(b < a);
+    EXPECT_FALSE(a < b);
+
+    // Floating point keeps comparing elements with ==.
+    rdsl::devector<double> zeros{0.0, 1.0};
+    rdsl::devector<double> negative_zeros{-0.0, 1.0};
+    EXPECT_TRUE(zeros == negative_zeros);
+}
+
+TEST(CompareTest, SearchTest) {
+    std::mt19937 gen(7);
+    check_search<std::uint8_t>(gen);
+    check_search<std::int16_t>(gen);
+    check_search<std::int32_t>(gen);
+    check_search<std::uint64_t>(gen);
+    check_search<float>(gen);
+
+    // A value whose bytes straddle two smaller ones isn't found.
+    rdsl::devector<std::uint16_t> halves{0x0100, 0x0001, 0x0100};
+    EXPECT_FALSE(halves.contains(0x0101));
+    EXPECT_FALSE(halves.contains(0));
+    EXPECT_EQ(halves.count(0x0100), 2);
+    EXPECT_EQ(halves.find(0x0001) - halves.begin(), 1);
+
+    const rdsl::devector<std::string> strings{"x", "y", "x"};
+    EXPECT_EQ(strings.count("x"), 2);
+    EXPECT_EQ(strings.find("y"), strings.begin() + 1);
+    EXPECT_FALSE(strings.contains("z"));
+}
+
+#if defined(DEVECTOR_SIMD_SSE2)
+TEST(CompareTest, KernelTest) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> byte(0, 2);
+    unsigned char a[100], b[100];
+    const rdsl::simd::pattern<std::uint32_t> ones(0x01010101);
+
+    for(int round = 0; round < 1000; ++round){
+        for(size_t i = 0; i < sizeof(a); ++i){
+            a[i] = b[i] = static_cast<unsigned char>(byte(gen));
+        }
+        const size_t n = gen() % 97, at = gen() % 100;
+        b[at] = 7;
+
+        const size_t differ = std::mismatch(a, a + n, b).first - a;
+        EXPECT_EQ(rdsl::simd::sse2::mismatch(a, b, n), differ);
+
+        size_t found = n / 4 * 4, count = 0;
+        for(size_t i = 0; i + 4 <= n; i += 4){
+            if(!std::memcmp(a + i, ones.bytes, 4)){
+                found = std::min(found, i);
+                ++count;
+            }
+        }
+        EXPECT_EQ(rdsl::simd::sse2::find<4>(a, n / 4 * 4, ones.bytes), found);
+        EXPECT_EQ(rdsl::simd::sse2::count<4>(a, n / 4 * 4, ones.bytes), count);
+
+#if defined(DEVECTOR_SIMD_AVX2)
+        if(rdsl::simd::supported() == rdsl::simd::isa::avx2){
+            EXPECT_EQ(rdsl::simd::avx2::mismatch(a, b, n), differ);
+            EXPECT_EQ(rdsl::simd::avx2::find<4>(a, n / 4 * 4, ones.bytes), found);
+            EXPECT_EQ(rdsl::simd::avx2::count<4>(a, n / 4 * 4, ones.bytes), count);
+        }
+#endif
+    }
+}
+#endif
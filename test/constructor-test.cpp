@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "rdsl/devector.hpp"
 
+#include <string>
+#include <vector>
 
 TEST(ConstructorTest, defaultConstructor) {
     rdsl::devector<int> vec;
@@ -96,3 +98,67 @@ TEST(ConstructorTest, ilConstructor) {
         ASSERT_EQ(i, vec0[i]);
     }
 }
+
+TEST(ConstructorTest, bufferConstructor) {
+    // A block from the allocator, filled by someone else, taken over without a copy.
+    std::allocator<int> alloc;
+    int* const arr = alloc.allocate(100);
+    for(int i = 0; i < 10; ++i){
+        arr[40 + i] = i;
+    }
+
+    rdsl::devector<int> vec0(rdsl::adopt_buffer, rdsl::devector<int>::raw_buffer{arr, 100, arr + 40, arr + 50}, alloc);
+    EXPECT_EQ(vec0.data(), arr);
+    EXPECT_EQ(vec0.capacity(), 100);
+    EXPECT_EQ(vec0.size(), 10);
+    EXPECT_EQ(vec0.begin() - vec0.data(), 40);
+    EXPECT_EQ(vec0[9], 9);
+
+    vec0.push_front(-1);
+    const rdsl::devector<int>::raw_buffer released = vec0.release();
+    EXPECT_EQ(released.arr, arr);
+    EXPECT_EQ(released.capacity, 100);
+    EXPECT_EQ(released.end - released.begin, 11);
+    EXPECT_EQ(*released.begin, -1);
+    EXPECT_EQ(vec0.data(), nullptr);
+    EXPECT_EQ(vec0.capacity(), 0);
+    EXPECT_TRUE(vec0.empty());
+
+    rdsl::devector<int> vec1(rdsl::adopt_buffer, released);
+    EXPECT_EQ(vec1.begin(), released.begin);
+    EXPECT_EQ(vec1.size(), 11);
+
+    const rdsl::devector<std::string>::raw_buffer empty = rdsl::devector<std::string>().release();
+    EXPECT_EQ(empty.capacity, 0);
+    rdsl::devector<std::string> vec2(rdsl::adopt_buffer, empty);
+    EXPECT_TRUE(vec2.empty());
+}
+
+TEST(ConstructorTest, vectorConversion) {
+    std::vector<int> ints{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    rdsl::devector<int> vec0(std::move(ints));
+    EXPECT_EQ(vec0, (rdsl::devector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(vec0.capacity(), 10);
+    EXPECT_TRUE(ints.empty());
+    EXPECT_EQ(ints.capacity(), 0);
+
+    vec0.push_front(-1);
+    const std::vector<int> back = std::move(vec0).to_vector();
+    EXPECT_EQ(back, (std::vector<int>{-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(vec0.data(), nullptr);
+    EXPECT_EQ(vec0.capacity(), 0);
+    EXPECT_TRUE(vec0.empty());
+    vec0.push_back(1);
+    EXPECT_EQ(vec0.size(), 1);
+
+    std::vector<std::string> strings{"a", "b", std::string(100, 'c')};
+    const char* const heap = strings[2].data();
+    rdsl::devector<std::string> vec1(std::move(strings));
+    EXPECT_EQ(vec1.back().data(), heap); // moved, not copied
+    EXPECT_TRUE(strings.empty());
+
+    const std::vector<std::string> moved = std::move(vec1).to_vector();
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved[2].data(), heap);
+    EXPECT_TRUE(vec1.empty());
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "rdsl/incremental_devector.hpp"
+
+#include <deque>
+#include <random>
+#include <string>
+
+namespace{
+
+// Counts the moves incremental_devector makes while migrating.
+struct moved{
+    static size_t count;
+
+    int value;
+
+    moved(int value): value(value) {}
+    moved(const moved& x): value(x.value) {}
+    moved(moved&& x) noexcept: value(x.value) { ++count; }
+
+    bool operator==(const moved& x) const{ return value == x.value; }
+};
+
+size_t moved::count = 0;
+
+} //namespace
+
+TEST(IncrementalDevectorTest, BoundedMigrationTest) {
+    rdsl::incremental_devector<moved> vec;
+    size_t growths = 0;
+    for(int i = 0; i < 100000; ++i){
+        const size_t capacity = vec.capacity();
+        moved::count = 0;
+        if(i % 3){
+            vec.push_back(i);
+        }else{
+            vec.push_front(i);
+        }
+        growths += vec.capacity() != capacity;
+
+        // A handful of moves per push, however big the container is.
+        ASSERT_LE(moved::count, 8);
+        if(vec.capacity() != capacity){
+            EXPECT_TRUE(vec.migrating() || vec.size() < 8);
+        }
+    }
+    EXPECT_GT(growths, 10);
+
+    vec.linearize();
+    EXPECT_FALSE(vec.migrating());
+    EXPECT_EQ(vec.pending(), 0);
+    EXPECT_EQ(vec.size(), 100000);
+}
+
+TEST(IncrementalDevectorTest, QueueTest) {
+    // A queue moving through the array migrates to one sized by its elements, rather than growing without bound.
+    rdsl::incremental_devector<moved> queue;
+    for(int i = 0; i < 8; ++i){
+        queue.push_back(i);
+    }
+    for(int i = 8; i < 1000000; ++i){
+        moved::count = 0;
+        queue.push_back(i);
+        ASSERT_EQ(queue.front().value, i - 8);
+        queue.pop_front();
+        ASSERT_LE(moved::count, 8);
+        ASSERT_LE(queue.capacity(), 32);
+    }
+    EXPECT_EQ(queue.size(), 8);
+    EXPECT_EQ(queue.back().value, 999999);
+
+    // Same from the front, after a burst drained down to a few elements.
+    rdsl::incremental_devector<int> reversed;
+    for(int i = 0; i < 100000; ++i){
+        reversed.push_front(i);
+    }
+    while(reversed.size() > 100){
+        reversed.pop_back();
+    }
+    for(int i = 100000; i < 1000000; ++i){
+        reversed.push_front(i);
+        ASSERT_EQ(reversed.back(), i - 100);
+        reversed.pop_back();
+    }
+    EXPECT_LE(reversed.capacity(), 400);
+}
+
+TEST(IncrementalDevectorTest, ModifiersTest) {
+    std::mt19937 gen(3);
+    rdsl::incremental_devector<std::string> vec;
+    std::deque<std::string> expected;
+
+    for(int i = 0; i < 20000; ++i){
+        const std::string val = std::to_string(i);
+        switch(gen() % 5){
+        case 0:
+        case 1:
+            vec.push_back(val);
+            expected.push_back(val);
+            break;
+        case 2:
+            vec.emplace_front(val);
+            expected.push_front(val);
+            break;
+        case 3:
+            if(!expected.empty()){
+                vec.pop_back();
+                expected.pop_back();
+            }
+            break;
+        case 4:
+            if(!expected.empty()){
+                vec.pop_front();
+                expected.pop_front();
+            }
+            break;
+        }
+
+        ASSERT_EQ(vec.size(), expected.size());
+        if(i % 97 == 0){
+            ASSERT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+        }
+    }
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+    EXPECT_EQ(vec.at(0), expected.front());
+    EXPECT_THROW(vec.at(vec.size()), std::out_of_range);
+
+    // Copies & moves taken mid migration hold the same elements.
+    while(!vec.migrating()){
+        vec.push_back("x");
+        expected.push_back("x");
+    }
+    rdsl::incremental_devector<std::string> copy = vec;
+    EXPECT_EQ(copy, vec);
+    rdsl::incremental_devector<std::string> moved_to = std::move(vec);
+    EXPECT_EQ(moved_to, copy);
+    EXPECT_TRUE(vec.empty());
+
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.migrating());
+
+    const auto dev = moved_to.to_devector();
+    EXPECT_TRUE(std::equal(dev.begin(), dev.end(), expected.begin()));
+}
+
+TEST(IncrementalDevectorTest, DrainTest) {
+    rdsl::incremental_devector<int> vec{1, 2, 3};
+    EXPECT_EQ(vec.capacity(), 3);
+
+    // Popping the elements still waiting in the old array releases it once they're gone.
+    int next = 4;
+    while(vec.pending() < 10){
+        vec.push_back(next++);
+    }
+    ASSERT_TRUE(vec.migrating());
+    EXPECT_EQ(vec.front(), 1);
+    EXPECT_EQ(vec.back(), next - 1);
+    while(!vec.empty()){
+        vec.pop_front();
+    }
+    EXPECT_FALSE(vec.migrating());
+
+    vec.reserve(100);
+    for(int i = 0; i < 10; ++i){
+        vec.push_back(i);
+    }
+    const int* const first = vec.linearize();
+    EXPECT_EQ(first[9], 9);
+    EXPECT_EQ(vec.capacity(), 100);
+}
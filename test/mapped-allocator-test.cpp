@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "rdsl/mapped_allocator.hpp"
+
+#include <cstdio>
+#include <string>
+
+struct record{
+    long long id;
+    double value;
+};
+
+static std::string temp_file(const char* name){
+    const std::string path = testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+TEST(MappedAllocatorTest, ReopenTest) {
+    const std::string path = temp_file("devector-reopen.bin");
+
+    {
+        rdsl::mapped_devector<record> vec{rdsl::mapped_allocator<record>(path)};
+        for(long long i = 0; i < 100000; ++i){
+            vec.push_back({i, i * 0.5});
+            vec.push_front({-i, i * 0.25});
+        }
+        vec.erase(vec.begin() + 10, vec.begin() + 20);
+        rdsl::sync(vec);
+    }
+
+    {
+        auto vec = rdsl::open_mapped<record>(path);
+        ASSERT_EQ(vec.size(), 199990);
+        EXPECT_EQ(vec.front().id, -99999);
+        EXPECT_EQ(vec[10].id, -99979);
+        EXPECT_EQ(vec.back().id, 99999);
+        EXPECT_EQ(vec.back().value, 99999 * 0.5);
+
+        // Keeps growing & shrinking inside the same file.
+        for(long long i = 0; i < 1000; ++i){
+            vec.insert(vec.begin() + vec.size() / 2, {i, 0});
+        }
+        vec.shrink_to_fit();
+        EXPECT_EQ(vec.capacity(), vec.size());
+        rdsl::sync(vec);
+    }
+
+    auto vec = rdsl::open_mapped<record>(path);
+    ASSERT_EQ(vec.size(), 200990);
+    EXPECT_EQ(vec.capacity(), 200990);
+    EXPECT_EQ(vec.front().id, -99999);
+    EXPECT_EQ(vec[(vec.size() - 1) / 2].id, 999);
+    EXPECT_EQ(vec.back().id, 99999);
+}
+
+TEST(MappedAllocatorTest, AnonymousTest) {
+    const std::string path = temp_file("devector-anonymous.bin");
+    rdsl::mapped_allocator<int> alloc(path);
+
+    rdsl::mapped_devector<int> vec(100, 7, alloc);
+    rdsl::mapped_devector<int> copy(vec);
+
+    // The file's block is taken, the copy lives in anonymous memory.
+    EXPECT_EQ(copy.get_allocator(), vec.get_allocator());
+    EXPECT_NE(copy.data(), vec.data());
+    EXPECT_EQ(copy, vec);
+
+    copy.resize_back(10000, 3);
+    EXPECT_EQ(copy[99], 7);
+    EXPECT_EQ(copy.back(), 3);
+
+    rdsl::mapped_devector<int> plain; // default constructed, never touches a file
+    plain.assign(copy.begin(), copy.end());
+    EXPECT_EQ(plain, copy);
+
+    EXPECT_THROW(rdsl::mapped_allocator<double>{path}, std::runtime_error);
+}
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 #include "rdsl/devector.hpp"
 
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rdsl{
+template<class T>
+struct is_trivially_relocatable<std::unique_ptr<T>>: std::true_type {};
+}
+
 struct input_it: public std::iterator<std::input_iterator_tag, int> {
     input_it(const input_it&) = default;
     input_it(input_it&&) noexcept = default;
@@ -172,3 +182,352 @@ TEST(ModifiersTest, InsertEraseTest) {
     EXPECT_EQ(vec[14], 432);
     EXPECT_EQ(vec[15], 4);
 }
+
+TEST(ModifiersTest, RelocationTest) {
+    rdsl::devector<std::unique_ptr<int>> vec;
+
+    for(int i = 0; i < 20; ++i){
+        vec.push_back(std::unique_ptr<int>(new int(i)));
+        vec.push_front(std::unique_ptr<int>(new int(-i - 1)));
+    }
+
+    vec.insert(vec.begin() + 5, std::unique_ptr<int>(new int(100)));
+    vec.insert(vec.end() - 5, std::unique_ptr<int>(new int(200)));
+    vec.erase(vec.begin() + 10, vec.begin() + 14);
+    vec.erase(vec.end() - 8, vec.end() - 6);
+
+    rdsl::devector<int> result;
+    for(int i = 0; i < 20; ++i){
+        result.push_back(i);
+        result.push_front(-i - 1);
+    }
+    result.insert(result.begin() + 5, 100);
+    result.insert(result.end() - 5, 200);
+    result.erase(result.begin() + 10, result.begin() + 14);
+    result.erase(result.end() - 8, result.end() - 6);
+
+    ASSERT_EQ(vec.size(), result.size());
+    for(size_t i = 0; i < vec.size(); ++i){
+        EXPECT_EQ(*vec[i], result[i]);
+    }
+
+    rdsl::devector<std::string> strings;
+    for(int i = 0; i < 20; ++i){
+        strings.push_back(std::string(32, 'a' + i));
+    }
+    strings.shrink_to_fit();
+    strings.insert(strings.begin() + 3, std::string(32, 'z'));
+
+    EXPECT_EQ(strings.size(), 21);
+    EXPECT_EQ(strings[2], std::string(32, 'a' + 2));
+    EXPECT_EQ(strings[3], std::string(32, 'z'));
+    EXPECT_EQ(strings[4], std::string(32, 'a' + 3));
+    EXPECT_EQ(strings[20], std::string(32, 'a' + 19));
+}
+
+struct no_recenter{
+    static size_t off_by(size_t free_blocks) noexcept{
+        return free_blocks / 2;
+    }
+
+    static float recenter_ratio() noexcept{
+        return 1.0f;
+    }
+};
+
+TEST(ModifiersTest, RecenterTest) {
+    rdsl::devector<int> vec;
+    rdsl::devector<std::string> strings;
+
+    for(int i = 0; i < 64; ++i){
+        vec.push_back(i);
+        strings.push_back(std::to_string(i));
+    }
+
+    const auto capacity = vec.capacity();
+    for(int i = 64; i < 10000; ++i){
+        vec.pop_front();
+        vec.push_back(i);
+        strings.pop_front();
+        strings.push_back(std::to_string(i));
+    }
+
+    EXPECT_EQ(vec.capacity(), capacity);
+    EXPECT_EQ(strings.capacity(), capacity);
+    ASSERT_EQ(vec.size(), 64);
+    ASSERT_EQ(strings.size(), 64);
+    for(int i = 0; i < 64; ++i){
+        EXPECT_EQ(vec[i], 10000 - 64 + i);
+        EXPECT_EQ(strings[i], std::to_string(10000 - 64 + i));
+    }
+
+    for(int i = 0; i < 10000; ++i){
+        vec.pop_back();
+        vec.push_front(i);
+    }
+    EXPECT_EQ(vec.capacity(), capacity);
+    EXPECT_EQ(vec.front(), 9999);
+    EXPECT_EQ(vec.back(), 10000 - 64);
+
+    rdsl::devector<int, std::allocator<int>, no_recenter> growing(10, 0);
+    growing.pop_front();
+    growing.push_back(1);
+    EXPECT_GT(growing.capacity(), 10);
+}
+
+TEST(ModifiersTest, PushOwnElementTest) {
+    rdsl::devector<int> vec;
+    rdsl::devector<std::string> strings;
+    for(int i = 0; i < 8; ++i){
+        vec.push_back(i);
+        strings.push_back(std::to_string(i));
+    }
+
+    // Rotating pushes an element of the container while making room recenters or grows it.
+    for(int i = 0; i < 100; ++i){
+        vec.push_back(vec.front());
+        vec.pop_front();
+        strings.push_back(strings.front());
+        strings.pop_front();
+    }
+    for(int i = 0; i < 8; ++i){
+        EXPECT_EQ(vec[i], (i + 100) % 8);
+        EXPECT_EQ(strings[i], std::to_string((i + 100) % 8));
+    }
+
+    for(int i = 0; i < 100; ++i){
+        vec.push_front(vec.back());
+        vec.pop_back();
+        strings.emplace_front(std::move(strings.back()));
+        strings.pop_back();
+    }
+    for(int i = 0; i < 8; ++i){
+        EXPECT_EQ(vec[i], i);
+        EXPECT_EQ(strings[i], std::to_string(i));
+    }
+
+    for(int i = 0; i < 100; ++i){
+        vec.push_back(vec.front());
+        strings.emplace_front(strings.back());
+    }
+    EXPECT_EQ(vec.back(), 0);
+    EXPECT_EQ(strings.front(), "7");
+}
+
+struct always_recenter{
+    static size_t off_by(size_t free_blocks) noexcept{
+        return free_blocks / 2;
+    }
+
+    static bool shift_shorter_side() noexcept{
+        return false;
+    }
+};
+
+TEST(ModifiersTest, ShorterSideInsertTest) {
+    rdsl::devector<int> vec;
+    rdsl::devector<std::string> strings;
+    rdsl::devector<int, std::allocator<int>, always_recenter> recentering;
+    vec.reserve(100);
+    strings.reserve(100);
+    recentering.reserve(100);
+
+    for(int i = 0; i < 20; ++i){
+        vec.push_back(i);
+        strings.push_back(std::to_string(i));
+        recentering.push_back(i);
+    }
+
+    // Near the back only the tail moves, near the front only the head does.
+    const int* first = &vec.front();
+    const std::string* first_string = &strings.front();
+    vec.insert(vec.end() - 2, 3, -1);
+    strings.insert(strings.end() - 2, 3, "-1");
+    EXPECT_EQ(&vec.front(), first);
+    EXPECT_EQ(&strings.front(), first_string);
+
+    const int* last = &vec.back();
+    const std::string* last_string = &strings.back();
+    vec.insert(vec.begin() + 1, 2, -2);
+    strings.insert(strings.begin() + 1, 2, "-2");
+    EXPECT_EQ(&vec.back(), last);
+    EXPECT_EQ(&strings.back(), last_string);
+
+    recentering.insert(recentering.end() - 2, 3, -1);
+    recentering.insert(recentering.begin() + 1, 2, -2);
+
+    rdsl::devector<int> result{0, -2, -2};
+    for(int i = 1; i < 18; ++i){
+        result.push_back(i);
+    }
+    result.insert(result.end(), {-1, -1, -1, 18, 19});
+
+    ASSERT_EQ(vec.size(), result.size());
+    ASSERT_EQ(strings.size(), result.size());
+    EXPECT_EQ(vec, result);
+    EXPECT_EQ(recentering, (rdsl::devector<int, std::allocator<int>, always_recenter>(result.begin(), result.end())));
+    for(size_t i = 0; i < result.size(); ++i){
+        EXPECT_EQ(strings[i], std::to_string(result[i]));
+    }
+
+    // The shorter side has no room left, the longer one still does.
+    while(vec.begin() != vec.data()){
+        vec.insert(vec.begin() + 1, 0);
+    }
+    const int* back = &vec.back();
+    vec.insert(vec.begin() + 1, 7);
+    EXPECT_EQ(vec[1], 7);
+    EXPECT_NE(&vec.back(), back);
+    EXPECT_EQ(vec.begin(), vec.data());
+}
+
+TEST(ModifiersTest, ShorterSideEraseTest) {
+    rdsl::devector<int> vec;
+    rdsl::devector<std::string> strings;
+    rdsl::devector<int, std::allocator<int>, always_recenter> recentering;
+    rdsl::devector<std::string, std::allocator<std::string>, always_recenter> recentering_strings;
+
+    for(int i = 0; i < 40; ++i){
+        vec.push_back(i);
+        strings.push_back(std::to_string(i));
+        recentering.push_back(i);
+        recentering_strings.push_back(std::to_string(i));
+    }
+
+    // Near the back only the tail moves, near the front only the head does.
+    const int* first = &vec.front();
+    const std::string* first_string = &strings.front();
+    EXPECT_EQ(*vec.erase(vec.end() - 5, vec.end() - 2), 38);
+    EXPECT_EQ(*strings.erase(strings.end() - 5, strings.end() - 2), "38");
+    EXPECT_EQ(&vec.front(), first);
+    EXPECT_EQ(&strings.front(), first_string);
+
+    const int* last = &vec.back();
+    const std::string* last_string = &strings.back();
+    EXPECT_EQ(*vec.erase(vec.begin() + 2, vec.begin() + 6), 6);
+    EXPECT_EQ(*strings.erase(strings.begin() + 2, strings.begin() + 6), "6");
+    EXPECT_EQ(&vec.back(), last);
+    EXPECT_EQ(&strings.back(), last_string);
+
+    EXPECT_EQ(*recentering.erase(recentering.end() - 5, recentering.end() - 2), 38);
+    EXPECT_EQ(*recentering_strings.erase(recentering_strings.end() - 5, recentering_strings.end() - 2), "38");
+    EXPECT_EQ(*recentering.erase(recentering.begin() + 2, recentering.begin() + 6), 6);
+    EXPECT_EQ(*recentering_strings.erase(recentering_strings.begin() + 2, recentering_strings.begin() + 6), "6");
+
+    rdsl::devector<int> result{0, 1};
+    for(int i = 6; i < 35; ++i){
+        result.push_back(i);
+    }
+    result.insert(result.end(), {38, 39});
+
+    EXPECT_EQ(vec, result);
+    EXPECT_EQ(recentering, (rdsl::devector<int, std::allocator<int>, always_recenter>(result.begin(), result.end())));
+    ASSERT_EQ(strings.size(), result.size());
+    ASSERT_EQ(recentering_strings.size(), result.size());
+    for(size_t i = 0; i < result.size(); ++i){
+        EXPECT_EQ(strings[i], std::to_string(result[i]));
+        EXPECT_EQ(recentering_strings[i], std::to_string(result[i]));
+    }
+}
+
+// A single pass range that knows its size, like a counted view over a stream.
+struct sized_input_range{
+    input_it begin() const { return input_it(0); }
+    input_it end() const { return input_it(count); }
+    size_t size() const { return count; }
+
+    int count;
+};
+
+struct input_range{
+    input_it begin() const { return input_it(0); }
+    input_it end() const { return input_it(count); }
+
+    int count;
+};
+
+TEST(ModifiersTest, RangeTest) {
+    using counted = rdsl::devector<int, std::allocator<int>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats>;
+
+    std::vector<int> batch;
+    for(int i = 0; i < 10000; ++i){
+        batch.push_back(i);
+    }
+
+    counted vec;
+    vec.append_range(batch);
+    EXPECT_EQ(vec.stats().reallocations, 1);
+    EXPECT_EQ(vec.stats().bytes_allocated, vec.capacity() * sizeof(int));
+
+    vec.prepend_range(sized_input_range{5});
+    EXPECT_EQ(vec.stats().reallocations, 2);
+    vec.append_range(std::list<int>{-1, -2});
+    vec.insert_range(vec.begin() + 7, std::initializer_list<int>{-3, -4});
+
+    ASSERT_EQ(vec.size(), 10009);
+    for(int i = 0; i < 5; ++i){
+        EXPECT_EQ(vec[i], i);
+    }
+    EXPECT_EQ(vec[5], 0);
+    EXPECT_EQ(vec[6], 1);
+    EXPECT_EQ(vec[7], -3);
+    EXPECT_EQ(vec[8], -4);
+    EXPECT_EQ(vec[9], 2);
+    EXPECT_EQ(vec[10006], 9999);
+    EXPECT_EQ(vec[10007], -1);
+    EXPECT_EQ(vec[10008], -2);
+
+    // Without a size the elements are pushed one by one, still in order.
+    rdsl::devector<int> unsized{100, 200, 300};
+    unsized.prepend_range(input_range{3});
+    unsized.append_range(input_range{2});
+    unsized.insert_range(unsized.begin() + 4, input_range{2});
+    EXPECT_EQ(unsized, (rdsl::devector<int>{0, 1, 2, 100, 0, 1, 200, 300, 0, 1}));
+
+    int raw[] = {7, 8};
+    rdsl::devector<std::string> strings{"b"};
+    strings.prepend_range(std::vector<std::string>{"a0", "a1"});
+    strings.append_range(std::vector<std::string>{"c"});
+    EXPECT_EQ(strings, (rdsl::devector<std::string>{"a0", "a1", "b", "c"}));
+    unsized.insert_range(unsized.end() - 1, raw);
+    EXPECT_EQ(unsized[9], 7);
+    EXPECT_EQ(unsized[10], 8);
+    EXPECT_EQ(unsized[11], 1);
+}
+
+TEST(ModifiersTest, BulkCopyFillTest) {
+    using counted = rdsl::devector<double, std::allocator<double>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats>;
+
+    counted vec(100, 1.5);
+    EXPECT_EQ(vec.stats().constructed, 100);
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 1.5), 100);
+
+    counted copy(vec);
+    EXPECT_EQ(copy, vec);
+    EXPECT_EQ(copy.stats().constructed, 100);
+
+    // Assigning over live elements only constructs the slots that weren't.
+    copy.assign(50, 0.0);
+    copy.push_front(2.0);
+    copy.stats().reset();
+    copy = vec;
+    EXPECT_EQ(copy, vec);
+    EXPECT_EQ(copy.stats().constructed, 100 - (51 - copy.stats().destroyed));
+    copy = {3.0, 4.0};
+    EXPECT_EQ(copy, (counted{3.0, 4.0}));
+
+    // The value inserted may be one of the elements getting shifted.
+    copy.insert(copy.begin() + 1, 5, copy.front());
+    copy.insert(copy.begin() + 1, 1000, copy.back());
+    EXPECT_EQ(copy.size(), 1007);
+    EXPECT_EQ(std::count(copy.begin(), copy.end(), 3.0), 6);
+    EXPECT_EQ(std::count(copy.begin(), copy.end(), 4.0), 1001);
+
+    rdsl::devector<unsigned char> bytes(1000, 0xAB);
+    bytes.insert(bytes.begin() + 500, 300, 0xCD);
+    const rdsl::devector<unsigned char> source(bytes);
+    bytes.assign(source.begin() + 400, 200);
+    EXPECT_EQ(bytes.size(), 200);
+    EXPECT_EQ(std::count(bytes.begin(), bytes.end(), 0xAB), 100);
+    EXPECT_EQ(std::count(bytes.begin(), bytes.end(), 0xCD), 100);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "rdsl/devector.hpp"
+
+TEST(OffsetByTest, AdaptiveTest) {
+    rdsl::devector<int, std::allocator<int>, rdsl::adaptive_offset_by> vec;
+
+    for(int i = 0; i < 1000; ++i){
+        vec.push_back(i);
+    }
+
+    // Back-only growth leaves next to nothing in front of begin.
+    EXPECT_LT(static_cast<size_t>(vec.begin() - vec.data()), (vec.capacity() - vec.size()) / 8 + 1);
+
+    for(int i = 0; i < 1000; ++i){
+        vec.push_front(i);
+    }
+
+    EXPECT_GT(static_cast<size_t>(vec.begin() - vec.data()), (vec.capacity() - vec.size()) / 2);
+
+    ASSERT_EQ(vec.size(), 2000);
+    for(int i = 0; i < 1000; ++i){
+        EXPECT_EQ(vec[i], 999 - i);
+        EXPECT_EQ(vec[1000 + i], i);
+    }
+
+    rdsl::adaptive_offset_by offs;
+    EXPECT_EQ(offs.off_by(100), 50);
+
+    offs.on_push_back(98);
+    EXPECT_EQ(offs.off_by(100), 1);
+    EXPECT_EQ(offs.back_demand, 49);
+
+    offs.on_pop_back(100);
+    offs.on_push_front(8);
+    EXPECT_EQ(offs.off_by(100), 90);
+}
+
+struct context_offset_by{
+    size_t off_by(const rdsl::offset_context& context){
+        last = context;
+        switch(context.operation){
+        case rdsl::offset_operation::push_back:
+            return 0;
+        case rdsl::offset_operation::push_front:
+            return static_cast<size_t>(-1);
+        default:
+            return context.free_blocks / 2;
+        }
+    }
+
+    // Erasing in the middle asks off_by where to go only when recentering.
+    static bool shift_shorter_side() noexcept{
+        return false;
+    }
+
+    rdsl::offset_context last;
+};
+
+TEST(OffsetByTest, ContextTest) {
+    rdsl::devector<int, std::allocator<int>, context_offset_by> vec(4, 1);
+
+    vec.push_back(2);
+    auto offs = vec.get_offset_by();
+    EXPECT_EQ(offs.last.operation, rdsl::offset_operation::push_back);
+    EXPECT_EQ(offs.last.size, 5);
+    EXPECT_EQ(offs.last.old_capacity, 4);
+    EXPECT_EQ(offs.last.new_capacity, vec.capacity());
+    EXPECT_EQ(offs.last.free_blocks, vec.capacity() - 5);
+    EXPECT_EQ(offs.last.old_free_front, 0);
+    EXPECT_EQ(offs.last.old_free_back, 0);
+    EXPECT_EQ(vec.begin(), vec.data());
+
+    vec.push_front(0);
+    offs = vec.get_offset_by();
+    EXPECT_EQ(offs.last.operation, rdsl::offset_operation::push_front);
+    // Clamped to the free blocks, the whole free space ends up in front.
+    EXPECT_EQ(vec.end(), vec.data() + vec.capacity());
+    EXPECT_EQ(vec[0], 0);
+    EXPECT_EQ(vec[1], 1);
+    EXPECT_EQ(vec[5], 2);
+
+    vec.reserve(100);
+    EXPECT_EQ(vec.get_offset_by().last.operation, rdsl::offset_operation::reserve);
+    vec.erase(vec.begin() + 1);
+    EXPECT_EQ(vec.get_offset_by().last.operation, rdsl::offset_operation::erase);
+    EXPECT_EQ(vec[0], 0);
+    EXPECT_EQ(vec[1], 1);
+    EXPECT_EQ(vec.size(), 5);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#if __cplusplus >= 201703L
+#include "rdsl/incremental_devector.hpp"
+#include "rdsl/recycling_resource.hpp"
+#include "rdsl/ring_devector.hpp"
+
+#include <string>
+#include <thread>
+
+namespace{
+
+// Forwards to new_delete_resource, counting what reaches it.
+struct counting_resource: std::pmr::memory_resource{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override{
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override{
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+        return this == &other;
+    }
+};
+
+}
+
+TEST(PmrTest, PropagationTest) {
+    counting_resource a, b;
+
+    rdsl::pmr::devector<std::string> x({"a", "b", "c"}, &a);
+    rdsl::pmr::devector<std::string> y({"d", "e"}, &b);
+
+    x = y;
+    EXPECT_EQ(x.get_allocator().resource(), &a);
+    EXPECT_EQ(x, y);
+
+    x = std::move(y);
+    EXPECT_EQ(x.get_allocator().resource(), &a);
+    EXPECT_EQ(y.get_allocator().resource(), &b);
+    EXPECT_EQ(x, (rdsl::pmr::devector<std::string>{"d", "e"}));
+
+    rdsl::pmr::devector<std::string> moved(std::move(x));
+    EXPECT_EQ(moved.get_allocator().resource(), &a);
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_TRUE(x.empty());
+
+    rdsl::pmr::devector<std::string> other({"f"}, &a);
+    const std::string* data = other.data();
+    swap(moved, other);
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_EQ(moved, (rdsl::pmr::devector<std::string>{"f"}));
+    EXPECT_EQ(other.size(), 2);
+}
+
+// Copies, moves & swaps between containers on different resources, which polymorphic_allocator never propagates.
+template<class Container>
+void check_propagation(){
+    counting_resource a, b;
+    {
+        Container x({"a", "b", "c"}, &a);
+        Container y({"d", "e"}, &b);
+
+        x = y;
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_EQ(x, y);
+
+        y.push_back("f");
+        x = std::move(y);
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_EQ(y.get_allocator().resource(), &b);
+        EXPECT_EQ(x, (Container{"d", "e", "f"}));
+
+        Container z({"g"}, &b);
+        x.swap(z);
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_EQ(z.get_allocator().resource(), &b);
+        EXPECT_EQ(x, (Container{"g"}));
+        EXPECT_EQ(z.size(), 3);
+    }
+
+    // Every array went back to the resource it came from.
+    EXPECT_EQ(a.allocations, a.deallocations);
+    EXPECT_EQ(b.allocations, b.deallocations);
+}
+
+TEST(PmrTest, IncrementalDevectorTest) {
+    check_propagation<rdsl::incremental_devector<std::string, std::pmr::polymorphic_allocator<std::string>>>();
+}
+
+TEST(PmrTest, RingDevectorTest) {
+    using ring = rdsl::ring_devector<std::string, std::pmr::polymorphic_allocator<std::string>>;
+    counting_resource a, b;
+    {
+        ring x(&a), y(&b);
+        for(const char* val: {"a", "b", "c"}){
+            x.push_back(val);
+        }
+        y.push_front("e");
+        y.push_front("d");
+
+        x = y;
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin(), y.end()));
+
+        y.push_back("f");
+        x = std::move(y);
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_EQ(y.get_allocator().resource(), &b);
+        EXPECT_EQ(x.size(), 3);
+        EXPECT_EQ(x.back(), "f");
+
+        ring z(&b);
+        z.push_back("g");
+        swap(x, z);
+        EXPECT_EQ(x.get_allocator().resource(), &a);
+        EXPECT_EQ(z.get_allocator().resource(), &b);
+        EXPECT_EQ(x.front(), "g");
+        EXPECT_EQ(z.size(), 3);
+        EXPECT_EQ(z.front(), "d");
+    }
+
+    // Every array went back to the resource it came from.
+    EXPECT_EQ(a.allocations, a.deallocations);
+    EXPECT_EQ(b.allocations, b.deallocations);
+}
+
+TEST(PmrTest, RecyclingTest) {
+    counting_resource upstream;
+    size_t first;
+    {
+        rdsl::pmr::recycling_resource resource(64, &upstream);
+
+        for(int round = 0; round < 1000; ++round){
+            rdsl::pmr::devector<int> vec(&resource);
+            for(int i = 0; i < 200; ++i){
+                vec.push_back(i);
+                vec.push_front(i);
+            }
+            if(round == 0){
+                first = upstream.allocations;
+            }
+        }
+
+        // Every round after the first grows through the very same buffers.
+        EXPECT_EQ(upstream.allocations, first);
+        EXPECT_EQ(upstream.deallocations, 0);
+        EXPECT_EQ(resource.cached_blocks(), first);
+
+        // Other threads bypass the free lists.
+        std::thread([&]{
+            rdsl::pmr::devector<int> vec(10, 1, &resource);
+        }).join();
+        EXPECT_EQ(upstream.allocations, first + 1);
+        EXPECT_EQ(upstream.deallocations, 1);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+
+    rdsl::pmr::devector<int> vec(&rdsl::pmr::thread_recycling_resource());
+    vec.resize(100);
+    const size_t capacity = vec.capacity();
+    const int* data = vec.data();
+    vec = rdsl::pmr::devector<int>(&rdsl::pmr::thread_recycling_resource());
+
+    rdsl::pmr::devector<int> reused(&rdsl::pmr::thread_recycling_resource());
+    reused.reserve(capacity);
+    EXPECT_LE(reused.data(), data);
+    EXPECT_GE(reused.data() + reused.capacity(), data);
+}
+
+#endif
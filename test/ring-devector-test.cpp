@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "rdsl/ring_devector.hpp"
+
+#include <string>
+
+TEST(RingDevectorTest, WrapTest) {
+    rdsl::ring_devector<int> ring(8);
+
+    EXPECT_EQ(ring.capacity(), 8);
+    EXPECT_TRUE(ring.empty());
+
+    for(int i = 0; i < 8; ++i){
+        ring.push_back(i);
+    }
+    EXPECT_TRUE(ring.full());
+
+    const int* const storage = ring.first_segment().first;
+    for(int i = 8; i < 1000; ++i){
+        ring.pop_front();
+        ring.push_back(i);
+        EXPECT_EQ(ring.front(), i - 7);
+        EXPECT_EQ(ring.back(), i);
+    }
+    EXPECT_EQ(ring.capacity(), 8);
+
+    for(int i = 0; i < 1000; ++i){
+        ring.pop_back();
+        ring.push_front(-i);
+    }
+    EXPECT_EQ(ring.capacity(), 8);
+    EXPECT_EQ(ring.size(), 8);
+
+    int expected = -999;
+    for(int i: ring){
+        EXPECT_EQ(i, expected++);
+    }
+
+    auto one = ring.first_segment();
+    auto two = ring.second_segment();
+    EXPECT_EQ(one.second + two.second, 8);
+    EXPECT_TRUE(one.first >= storage && one.first < storage + 8);
+    if(two.second){
+        EXPECT_EQ(two.first, storage);
+        EXPECT_EQ(one.first + one.second, storage + 8);
+    }
+
+    const int* first = ring.linearize();
+    EXPECT_EQ(ring.second_segment().second, 0);
+    for(int i = 0; i < 8; ++i){
+        EXPECT_EQ(first[i], -999 + i);
+    }
+
+    auto vec = ring.to_devector();
+    EXPECT_EQ(vec.size(), 8);
+    for(int i = 0; i < 8; ++i){
+        EXPECT_EQ(vec[i], ring[i]);
+    }
+}
+
+TEST(RingDevectorTest, GrowTest) {
+    rdsl::ring_devector<std::string> ring;
+
+    for(int i = 0; i < 100; ++i){
+        ring.push_back(std::to_string(i));
+        ring.push_front(std::to_string(-i));
+    }
+
+    EXPECT_EQ(ring.size(), 200);
+    EXPECT_GE(ring.capacity(), 200);
+    EXPECT_EQ(ring.front(), "-99");
+    EXPECT_EQ(ring.back(), "99");
+    EXPECT_EQ(ring.at(100), "0");
+    EXPECT_THROW(ring.at(200), std::out_of_range);
+
+    auto copy = ring;
+    EXPECT_EQ(copy.size(), 200);
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), ring.begin()));
+
+    rdsl::ring_devector<std::string> moved;
+    moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 200);
+    EXPECT_TRUE(copy.empty());
+
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 200);
+    EXPECT_EQ(moved[0], "-99");
+    EXPECT_EQ(moved[199], "99");
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+
+    // An empty ring gives its array back.
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 0);
+    moved.push_back("x");
+    EXPECT_EQ(moved.front(), "x");
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "rdsl/small_devector.hpp"
+
+#include <string>
+
+static size_t heap_blocks = 0;
+
+template<class T>
+struct counting_allocator{
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n){
+        ++heap_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept{
+        --heap_blocks;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<class U>
+    bool operator==(const counting_allocator<U>&) const noexcept{ return true; }
+
+    template<class U>
+    bool operator!=(const counting_allocator<U>&) const noexcept{ return false; }
+};
+
+template<class T, size_t N>
+using small = rdsl::small_devector<T, N, counting_allocator<T>>;
+
+TEST(SmallDevectorTest, InlineTest) {
+    {
+        small<int, 8> vec;
+        EXPECT_EQ(vec.capacity(), 0);
+
+        vec.push_back(1);
+        EXPECT_EQ(vec.capacity(), 8);
+        for(int i = 2; i <= 4; ++i){
+            vec.push_back(i);
+            vec.push_front(-i);
+        }
+        vec.insert(vec.begin() + 3, 0);
+        vec.erase(vec.begin());
+        EXPECT_EQ(vec, (small<int, 8>{-3, -2, 0, 1, 2, 3, 4}));
+        EXPECT_EQ(heap_blocks, 0);
+
+        vec.push_back(5);
+        vec.push_front(-4);
+        EXPECT_EQ(vec.size(), 9);
+        EXPECT_EQ(heap_blocks, 1);
+        EXPECT_EQ(vec, (small<int, 8>{-4, -3, -2, 0, 1, 2, 3, 4, 5}));
+
+        // Back into the arena once it fits, staying there on further shrinks.
+        vec.pop_front();
+        vec.shrink_to_fit();
+        EXPECT_EQ(heap_blocks, 0);
+        EXPECT_EQ(vec.capacity(), 8);
+        vec.pop_front();
+        vec.shrink_to_fit();
+        EXPECT_EQ(heap_blocks, 0);
+        EXPECT_EQ(vec, (small<int, 8>{-2, 0, 1, 2, 3, 4, 5}));
+    }
+    EXPECT_EQ(heap_blocks, 0);
+}
+
+TEST(SmallDevectorTest, CopyMoveSwapTest) {
+    {
+        small<std::string, 4> a{"a", "b"};
+        small<std::string, 4> b(20, "long enough to live on the heap");
+        EXPECT_EQ(heap_blocks, 1);
+
+        // Copies get an arena of their own.
+        small<std::string, 4> copy = a;
+        EXPECT_EQ(heap_blocks, 1);
+        EXPECT_NE(copy.data(), a.data());
+
+        // Inline elements are moved one by one, heap buffers change hands.
+        small<std::string, 4> moved_a(std::move(copy));
+        EXPECT_EQ(moved_a, a);
+        const std::string* const heap = b.data();
+        small<std::string, 4> moved_b(std::move(b));
+        EXPECT_EQ(moved_b.data(), heap);
+        EXPECT_EQ(heap_blocks, 1);
+
+        // A full heap block too big for the arena is already as tight as it gets.
+        EXPECT_EQ(moved_b.capacity(), moved_b.size());
+        moved_b.shrink_to_fit();
+        EXPECT_EQ(moved_b.data(), heap);
+        EXPECT_EQ(heap_blocks, 1);
+
+        moved_a.swap(moved_b);
+        EXPECT_EQ(moved_a.data(), heap);
+        EXPECT_EQ(moved_b, a);
+        EXPECT_EQ(moved_a.size(), 20);
+        EXPECT_EQ(heap_blocks, 1);
+
+        moved_b = std::move(moved_a);
+        EXPECT_EQ(moved_b.data(), heap);
+        EXPECT_EQ(moved_b.size(), 20);
+        EXPECT_EQ(heap_blocks, 1);
+
+        moved_a = a;
+        moved_b = moved_a;
+        EXPECT_EQ(moved_b, a);
+        moved_b.shrink_to_fit();
+        EXPECT_EQ(heap_blocks, 0);
+    }
+    EXPECT_EQ(heap_blocks, 0);
+}
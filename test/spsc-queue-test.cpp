@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "rdsl/spsc_queue.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueueTest, GrowTest) {
+    rdsl::spsc_queue<std::string> queue(4);
+    std::string out;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(out));
+
+    for(int i = 0; i < 1000; ++i){
+        queue.push(std::to_string(i));
+    }
+    for(int i = 0; i < 500; ++i){
+        ASSERT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out, std::to_string(i));
+    }
+
+    std::vector<std::string> batch;
+    for(int i = 1000; i < 1100; ++i){
+        batch.push_back(std::to_string(i));
+    }
+    queue.push(batch.begin(), batch.size());
+
+    std::vector<std::string> popped;
+    EXPECT_EQ(queue.pop(std::back_inserter(popped), 1000), 600);
+    for(int i = 0; i < 600; ++i){
+        EXPECT_EQ(popped[i], std::to_string(500 + i));
+    }
+    EXPECT_TRUE(queue.empty());
+
+    // Whatever is left is destroyed along with the queue.
+    queue.push("left behind");
+}
+
+namespace{
+
+// Counts live instances, so destroying one twice shows.
+struct tracked{
+    static int live;
+
+    int value;
+
+    tracked(int value = 0): value(value) { ++live; }
+    tracked(const tracked& x): value(x.value) { ++live; }
+    tracked& operator=(const tracked&) = default;
+    ~tracked(){ --live; }
+};
+
+int tracked::live = 0;
+
+// An output iterator whose assignment throws once *limit* elements went through it.
+struct throwing_sink{
+    std::vector<int>* values;
+    size_t limit;
+
+    throwing_sink& operator*() noexcept{ return *this; }
+    throwing_sink& operator++() noexcept{ return *this; }
+
+    throwing_sink& operator=(const tracked& x){
+        if(values->size() == limit){
+            throw std::runtime_error("sink full");
+        }
+        values->push_back(x.value);
+        return *this;
+    }
+};
+
+} //namespace
+
+TEST(SpscQueueTest, ThrowingPopTest) {
+    {
+        rdsl::spsc_queue<tracked> queue(16);
+        for(int i = 0; i < 10; ++i){
+            queue.push(tracked(i));
+        }
+
+        std::vector<int> values;
+        EXPECT_THROW(queue.pop(throwing_sink{&values, 3}, 10), std::runtime_error);
+        EXPECT_EQ(values.size(), 3);
+        EXPECT_EQ(tracked::live, 7);
+
+        // The element that threw is still the front one.
+        tracked out;
+        ASSERT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out.value, 3);
+    }
+    EXPECT_EQ(tracked::live, 0);
+}
+
+TEST(SpscQueueTest, ThreadsTest) {
+    const int count = 200000;
+    rdsl::spsc_queue<int> queue(16);
+
+    std::thread producer([&queue]{
+        int batch[32];
+        for(int i = 0; i < count;){
+            if(i % 3){
+                queue.push(i++);
+            }else{
+                const int n = count - i < 32 ? count - i : 32;
+                for(int j = 0; j < n; ++j){
+                    batch[j] = i + j;
+                }
+                queue.push(batch, n);
+                i += n;
+            }
+        }
+    });
+
+    int expected = 0;
+    int buffer[64];
+    while(expected < count){
+        if(expected % 2){
+            int out;
+            if(queue.try_pop(out)){
+                ASSERT_EQ(out, expected++);
+            }
+        }else{
+            const auto n = queue.pop(buffer, 64);
+            for(size_t i = 0; i < n; ++i){
+                ASSERT_EQ(buffer[i], expected++);
+            }
+        }
+    }
+
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
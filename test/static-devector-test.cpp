@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "rdsl/static_devector.hpp"
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+
+TEST(StaticDevectorTest, ModifiersTest) {
+    rdsl::static_devector<int, 8> vec;
+    EXPECT_EQ(vec.capacity(), 8);
+    EXPECT_TRUE(vec.empty());
+
+    // An end running out of room slides the elements instead of failing.
+    for(int i = 0; i < 8; ++i){
+        EXPECT_TRUE(vec.push_back(i));
+    }
+    EXPECT_TRUE(vec.full());
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    vec.erase(vec.begin() + 2, vec.begin() + 4);
+    vec.pop_back();
+    EXPECT_TRUE(vec.push_front(-1));
+    EXPECT_TRUE(vec.emplace_front(-2));
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{-2, -1, 0, 1, 4, 5, 6}));
+
+    vec.insert(vec.begin() + 3, 9);
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{-2, -1, 0, 9, 1, 4, 5, 6}));
+    EXPECT_THROW(vec.insert(vec.begin() + 3, 9), std::length_error);
+    EXPECT_EQ(vec.size(), 8);
+
+    vec.resize_front(3);
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{4, 5, 6}));
+    vec.resize_back(6, 7);
+    vec.resize_front(8);
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{0, 0, 4, 5, 6, 7, 7, 7}));
+
+    std::list<int> list{1, 2};
+    vec.erase(vec.begin() + 1, vec.end() - 1);
+    vec.insert(vec.begin() + 1, list.begin(), list.end());
+    EXPECT_EQ(vec, (rdsl::static_devector<int, 8>{0, 1, 2, 7}));
+}
+
+TEST(StaticDevectorTest, OverflowPolicyTest) {
+    rdsl::static_devector<std::string, 4, rdsl::reject_on_overflow> vec(3, "a");
+
+    EXPECT_TRUE(vec.push_front("b"));
+    EXPECT_FALSE(vec.push_back("c"));
+    EXPECT_FALSE(vec.emplace_front("c"));
+    EXPECT_FALSE(vec.resize_back(5));
+    EXPECT_EQ(vec.insert(vec.begin() + 1, 2, "c"), vec.begin() + 1);
+    EXPECT_EQ(vec, (rdsl::static_devector<std::string, 4>{"b", "a", "a", "a"}));
+
+    std::istringstream words("d e f g h");
+    vec.pop_back();
+    vec.insert(vec.begin(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    EXPECT_EQ(vec.size(), 3);
+
+    // Throwing part way through an input range takes back what was appended, whatever threw.
+    rdsl::static_devector<std::string, 4> strict{"x", "y"};
+    std::istringstream more("d e f");
+    EXPECT_THROW(strict.insert(strict.begin() + 1, std::istream_iterator<std::string>(more), std::istream_iterator<std::string>()), std::length_error);
+    EXPECT_EQ(strict, (rdsl::static_devector<std::string, 4>{"x", "y"}));
+
+    rdsl::static_devector<std::string, 4, rdsl::reject_on_overflow> big{"1", "2", "3", "4", "5"};
+    EXPECT_TRUE(big.empty());
+    EXPECT_THROW((rdsl::static_devector<int, 2>{1, 2, 3}), std::length_error);
+}
+
+TEST(StaticDevectorTest, CopyMoveTest) {
+    rdsl::static_devector<std::string, 16> a;
+    for(int i = 0; i < 10; ++i){
+        a.push_front(std::string(20, char('a' + i)));
+    }
+
+    rdsl::static_devector<std::string, 16> b(a);
+    EXPECT_EQ(a, b);
+
+    rdsl::static_devector<std::string, 16> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a, c);
+
+    b = {"x", "y"};
+    b.swap(c);
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(c, (rdsl::static_devector<std::string, 16>{"x", "y"}));
+    EXPECT_LT(b, c);
+
+    c = a;
+    c.erase(c.begin() + 3);
+    c.insert(c.begin() + 6, "z");
+    c.erase(c.begin() + 2, c.begin() + 8);
+    EXPECT_EQ(c.size(), 4);
+    EXPECT_EQ(c[2], a[8]);
+}
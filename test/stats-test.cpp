@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "rdsl/devector.hpp"
+
+#include <string>
+
+template<class T>
+using counted = rdsl::devector<T, std::allocator<T>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats>;
+
+TEST(StatsTest, CountsTest) {
+    counted<int> vec;
+
+    for(int i = 0; i < 100; ++i){
+        vec.push_back(i);
+    }
+
+    const rdsl::devector_stats& stats = vec.stats();
+    EXPECT_EQ(stats.constructed, 100);
+    EXPECT_EQ(stats.destroyed, 0);
+    EXPECT_GT(stats.reallocations, 0);
+    EXPECT_EQ(stats.peak_capacity, vec.capacity());
+    EXPECT_EQ(stats.moved_bytes, stats.moved * sizeof(int));
+
+    vec.stats().reset();
+    EXPECT_EQ(stats.constructed, 0);
+    EXPECT_EQ(stats.peak_capacity, 0);
+
+    vec.reserve(200);
+    EXPECT_EQ(stats.reallocations, 1);
+    EXPECT_EQ(stats.moved, 100);
+    EXPECT_EQ(stats.bytes_allocated, 200 * sizeof(int));
+    EXPECT_EQ(stats.peak_capacity, 200);
+
+    vec.insert(vec.begin() + 50, 3, -1);
+    EXPECT_EQ(stats.constructed, 3);
+    EXPECT_EQ(stats.shifts, 1);
+
+    const size_t moved = stats.moved;
+    vec.erase(vec.begin() + 10, vec.begin() + 20);
+    EXPECT_EQ(stats.destroyed, 10);
+    EXPECT_EQ(stats.shifts, 2);
+    EXPECT_GT(stats.moved, moved);
+
+    vec.pop_front();
+    vec.pop_back();
+    EXPECT_EQ(stats.destroyed, 12);
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(stats.reallocations, 2);
+    EXPECT_EQ(stats.bytes_allocated, (200 + 91) * sizeof(int));
+    EXPECT_EQ(stats.peak_capacity, 200);
+    EXPECT_EQ(stats.constructed + 100, stats.destroyed + vec.size());
+}
+
+TEST(StatsTest, BalanceTest) {
+    counted<std::string> vec(10, "devector");
+
+    for(int i = 0; i < 1000; ++i){
+        vec.push_back("back");
+        vec.emplace_front("front");
+        vec.pop_front();
+    }
+
+    vec.resize_front(600);
+    vec.resize_back(800, "resized");
+    vec.erase(vec.end() - 5, vec.end());
+
+    counted<std::string> copy(vec.begin(), vec.begin() + 3);
+    vec = copy;
+    vec.assign(7, "assigned");
+
+    counted<std::string> moved(std::move(vec));
+
+    // Every element that entered a container either left it or is still there.
+    EXPECT_EQ(vec.stats().constructed - vec.stats().destroyed, vec.size());
+    EXPECT_EQ(moved.stats().constructed - moved.stats().destroyed, moved.size());
+    EXPECT_EQ(copy.stats().constructed - copy.stats().destroyed, copy.size());
+
+    // Without a statistics policy the container is exactly as big as before.
+    EXPECT_EQ(sizeof(rdsl::devector<std::string>), sizeof(void*) * 3 + sizeof(size_t));
+}
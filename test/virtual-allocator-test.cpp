@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "rdsl/virtual_allocator.hpp"
+
+#include <string>
+
+template<class T, size_t Reserve = rdsl::virtual_reserve>
+using counted = rdsl::devector<T, rdsl::virtual_allocator<T, Reserve>, rdsl::offset_by, rdsl::geometric_growth<>, rdsl::devector_stats>;
+
+TEST(VirtualAllocatorTest, GrowthTest) {
+    counted<long> vec;
+    vec.push_back(0);
+    vec.stats().reset();
+    const long* const first = &vec.front();
+
+    for(long i = 1; i <= 1000000; ++i){
+        vec.push_back(i);
+        vec.push_front(-i);
+    }
+    vec.insert(vec.begin(), 1000, 7);
+    vec.resize_back(vec.size() + 100000, 8);
+
+    // Every element stayed where it was constructed.
+    EXPECT_EQ(&vec[1000 + 1000000], first);
+    EXPECT_EQ(vec.stats().reallocations, 0);
+    EXPECT_EQ(vec.stats().moved, 0);
+    EXPECT_EQ(vec.front(), 7);
+    EXPECT_EQ(vec[1000], -1000000);
+    EXPECT_EQ(vec.back(), 8);
+
+    vec.reserve(vec.capacity() * 2);
+    EXPECT_EQ(&vec[1000 + 1000000], first);
+
+    // Copies get a reservation of their own.
+    const counted<long> copy = vec;
+    EXPECT_EQ(copy, vec);
+    EXPECT_NE(copy.data(), vec.data());
+}
+
+TEST(VirtualAllocatorTest, ExhaustedTest) {
+    // A 1MiB reservation holds 64Ki strings at most, growing past it moves them to a new one.
+    counted<std::string, size_t(1) << 20> vec;
+    const size_t max = vec.get_allocator().max_size();
+
+    vec.push_back("0");
+    vec.stats().reset();
+    for(size_t i = 1; i < max / 4; ++i){
+        vec.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(vec.stats().reallocations, 0);
+
+    // The block starts in the middle of its reservation, half of it is left at the back.
+    EXPECT_THROW(vec.resize_back(max + 1), std::length_error);
+    vec.resize_back(max / 2 + 1);
+    EXPECT_EQ(vec.stats().reallocations, 1);
+    EXPECT_EQ(vec[max / 4 - 1], std::to_string(max / 4 - 1));
+    EXPECT_EQ(vec.size(), max / 2 + 1);
+}
+
+TEST(VirtualAllocatorTest, QueueTest) {
+    // Used as a queue the elements are recentered inside the block, instead of the block extending forever.
+    counted<int> queue;
+    for(int i = 0; i < 8; ++i){
+        queue.push_back(i);
+    }
+    for(int i = 8; i < 1000000; ++i){
+        queue.push_back(i);
+        ASSERT_EQ(queue.front(), i - 8);
+        queue.pop_front();
+    }
+    EXPECT_LE(queue.capacity(), 64);
+    EXPECT_EQ(queue.size(), 8);
+    EXPECT_EQ(queue.back(), 999999);
+    EXPECT_GT(queue.stats().shifts, 0);
+
+    // The same from the other end, with enough elements for whole pages to be given back & touched again.
+    counted<long> reversed;
+    for(long i = 0; i < 10000; ++i){
+        reversed.push_front(i);
+    }
+    for(long i = 10000; i < 1000000; ++i){
+        reversed.push_front(i);
+        ASSERT_EQ(reversed.back(), i - 10000);
+        reversed.pop_back();
+    }
+    EXPECT_LE(reversed.capacity(), 40000);
+    EXPECT_EQ(reversed.front(), 999999);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "rdsl/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingDequeTest, OwnerTest) {
+    rdsl::work_stealing_deque<int> deque(4);
+    int out;
+
+    EXPECT_EQ(deque.capacity(), 4);
+    EXPECT_FALSE(deque.pop_back(out));
+    EXPECT_FALSE(deque.steal_front(out));
+
+    for(int i = 0; i < 100; ++i){
+        deque.push_back(i);
+    }
+    EXPECT_EQ(deque.size(), 100);
+    EXPECT_GE(deque.capacity(), 100);
+
+    ASSERT_TRUE(deque.steal_front(out));
+    EXPECT_EQ(out, 0);
+    ASSERT_TRUE(deque.pop_back(out));
+    EXPECT_EQ(out, 99);
+
+    for(int i = 98; i > 0; --i){
+        ASSERT_TRUE(deque.pop_back(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.pop_back(out));
+}
+
+TEST(WorkStealingDequeTest, ThievesTest) {
+    const int count = 100000;
+    rdsl::work_stealing_deque<int> deque(8);
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for(int i = 0; i < 3; ++i){
+        thieves.emplace_back([&]{
+            int out;
+            while(!done.load()){
+                if(deque.steal_front(out)){
+                    taken[out].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int out;
+    for(int i = 0; i < count; ++i){
+        deque.push_back(i);
+        if(i % 3 == 0 && deque.pop_back(out)){
+            taken[out].fetch_add(1);
+        }
+    }
+    while(deque.pop_back(out)){
+        taken[out].fetch_add(1);
+    }
+
+    done = true;
+    for(auto& thief: thieves){
+        thief.join();
+    }
+
+    for(int i = 0; i < count; ++i){
+        ASSERT_EQ(taken[i].load(), 1) << i;
+    }
+}